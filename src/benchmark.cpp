@@ -1,13 +1,20 @@
+#include <iomanip>
+
 #include "benchmark.h"
+#include "perfcounters.h"
+#include "thread.h"
 
 extern std::atomic_bool stopped;
+extern TranspositionTable TTable;
+extern ThreadPool Threads;
 
 namespace Bench
 {
 
-int startBench(int depth)
+int startBench(int depth, bool perfCounters, bool probCut)
 {
     U64 totalNodes = 0;
+    SearchStats stats;
 
     Limits limit;
     limit.depth = depth;
@@ -16,6 +23,13 @@ int startBench(int depth)
 
     int i = 1;
 
+    PerfCounters counters;
+    if (perfCounters)
+    {
+        counters.open();
+        counters.start();
+    }
+
     auto t1 = TimePoint::now();
 
     for (auto &fen : benchmarkfens)
@@ -31,18 +45,206 @@ int startBench(int depth)
         searcher.board.applyFen(fen);
         searcher.limit = limit;
         searcher.id = 0;
+        searcher.probCut = probCut;
 
         searcher.startThinking();
 
         totalNodes += searcher.nodes;
+        stats.merge(searcher.stats);
     }
 
     auto t2 = TimePoint::now();
+
+    if (perfCounters)
+        counters.stop();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
 
     std::cout << "\n" << totalNodes << " nodes " << signed((totalNodes / (ms + 1)) * 1000) << " nps " << std::endl;
 
-    print_mean();
+    if (perfCounters)
+        counters.print(totalNodes);
+
+    stats.print();
+
+    return 0;
+}
+
+struct SmpResult
+{
+    int threads;
+    U64 nodes;
+    int64_t ms;
+};
+
+int startBenchSmp(int depth, int maxThreads)
+{
+    Limits limit;
+    limit.depth = depth;
+    limit.nodes = 0;
+    limit.time = Time();
+
+    // 1, 2, 4 ... and maxThreads itself
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::vector<SmpResult> results;
+
+    for (int threads : threadCounts)
+    {
+        U64 totalNodes = 0;
+        int64_t totalMs = 0;
+
+        for (auto &fen : benchmarkfens)
+        {
+            Board board;
+            board.applyFen(fen);
+
+            TTable.clearTT();
+
+            auto t1 = TimePoint::now();
+
+            Threads.start_threads(board, limit, Movelist(), threads, false);
+
+            // the mainthread stops the helpers once it reached the depth
+            Threads.wait_threads();
+
+            auto t2 = TimePoint::now();
+
+            totalNodes += Threads.getNodes();
+            totalMs += std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+
+            Threads.stop_threads();
+        }
+
+        results.push_back({threads, totalNodes, totalMs});
+    }
+
+    const SmpResult &base = results.front();
+
+    std::cout << "\nSMP scaling, depth " << depth << "\n"
+              << std::setw(8) << "threads" << std::setw(14) << "nodes" << std::setw(10) << "ms" << std::setw(12)
+              << "nps" << std::setw(12) << "nps x" << std::setw(12) << "speedup" << std::setw(12) << "overhead"
+              << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (const auto &r : results)
+    {
+        const U64 nps = r.nodes * 1000 / (r.ms + 1);
+        const U64 baseNps = base.nodes * 1000 / (base.ms + 1);
+
+        // clang-format off
+        std::cout << std::setw(8)  << r.threads
+                  << std::setw(14) << r.nodes
+                  << std::setw(10) << r.ms
+                  << std::setw(12) << nps
+                  << std::setw(12) << double(nps) / std::max<U64>(baseNps, 1)
+                  << std::setw(12) << double(base.ms + 1) / (r.ms + 1)
+                  << std::setw(12) << double(r.nodes) / std::max<U64>(base.nodes, 1)
+                  << std::endl;
+        // clang-format on
+    }
+
+    std::cout << std::defaultfloat;
+
+    return 0;
+}
+
+int startBenchSee(int iterations)
+{
+    static constexpr int thresholds[] = {-300, -100, 0, 100, 300};
+
+    std::vector<Board> boards(benchmarkfens.size());
+    std::vector<std::vector<Move>> moves(benchmarkfens.size());
+
+    U64 captures = 0;
+
+    for (std::size_t i = 0; i < benchmarkfens.size(); i++)
+    {
+        boards[i].applyFen(benchmarkfens[i], false);
+
+        Movelist movelist;
+        Movegen::legalmoves<Movetype::ALL>(boards[i], movelist);
+
+        for (const auto &ext : movelist)
+        {
+            moves[i].push_back(ext.move());
+            captures += boards[i].pieceAtB(to(ext.move())) != None;
+        }
+    }
+
+    U64 calls = 0;
+    U64 passed = 0;
+
+    auto t1 = TimePoint::now();
+
+    for (int n = 0; n < iterations; n++)
+    {
+        for (std::size_t i = 0; i < boards.size(); i++)
+        {
+            for (const Move move : moves[i])
+            {
+                for (const int threshold : thresholds)
+                    passed += boards[i].see(move, threshold);
+            }
+
+            calls += moves[i].size() * std::size(thresholds);
+        }
+    }
+
+    auto t2 = TimePoint::now();
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+
+    std::cout << "SEE: " << calls / iterations << " calls per iteration (" << captures << " captures), " << passed
+              << " passed" << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << double(ns) / std::max<U64>(calls, 1) << " ns per call, "
+              << calls * 1000 / (ns / 1000000 + 1) << " calls per second" << std::endl;
+    std::cout << std::defaultfloat;
+
+    return 0;
+}
+
+int startBenchMovegen(int iterations)
+{
+    std::vector<Board> boards(benchmarkfens.size());
+
+    for (std::size_t i = 0; i < benchmarkfens.size(); i++)
+        boards[i].applyFen(benchmarkfens[i], false);
+
+    U64 calls = 0;
+    U64 moves = 0;
+
+    auto t1 = TimePoint::now();
+
+    for (int n = 0; n < iterations; n++)
+    {
+        for (auto &board : boards)
+        {
+            Movelist movelist;
+
+            // recompute the check and pin masks every time like a new node would
+            board.infoValid = false;
+            Movegen::legalmoves<Movetype::ALL>(board, movelist);
+
+            moves += movelist.size;
+            calls++;
+        }
+    }
+
+    auto t2 = TimePoint::now();
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+
+#ifdef SIMD_MOVEGEN
+    std::cout << "Movegen (simd): ";
+#else
+    std::cout << "Movegen: ";
+#endif
+    std::cout << moves / iterations << " moves per iteration" << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << double(ns) / std::max<U64>(calls, 1) << " ns per position, "
+              << moves * 1000 / (ns / 1000000 + 1) << " moves per second" << std::endl;
+    std::cout << std::defaultfloat;
 
     return 0;
 }
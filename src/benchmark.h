@@ -63,6 +63,30 @@ static const std::vector<std::string> benchmarkfens = {
     "4rrb1/1kp3b1/1p1p4/pP1Pn2p/5p2/1PR2P2/2P1NB1P/2KR1B2 w D - 0 21",
     "1rkr3b/1ppn3p/3pB1n1/6q1/R2P4/4N1P1/1P5P/2KRQ1B1 b Dbd - 0 14"};
 
-int startBench(int depth = 12);
+/// @brief search all bench positions to a fixed depth
+/// @param depth
+/// @param perfCounters also report hardware performance counters
+/// @param probCut search with ProbCut enabled
+/// @return
+int startBench(int depth = 12, bool perfCounters = false, bool probCut = false);
+
+/// @brief search all bench positions with 1, 2, 4 ... maxThreads threads and an empty TT,
+/// then compare time to depth, nps and searched nodes with the single threaded run
+/// @param depth
+/// @param maxThreads
+/// @return
+int startBenchSmp(int depth, int maxThreads);
+
+/// @brief time the static exchange evaluation on all moves of the bench positions
+/// with a few thresholds, the number of passed exchanges is printed as a checksum
+/// @param iterations
+/// @return
+int startBenchSee(int iterations);
+
+/// @brief time the legal move generation of the bench positions,
+/// the number of generated moves is printed as a checksum
+/// @param iterations
+/// @return
+int startBenchMovegen(int iterations);
 
 } // namespace Bench
@@ -0,0 +1,196 @@
+#include <bitset>
+#include <vector>
+
+#include "bitbase.h"
+
+namespace Bitbase
+{
+
+namespace
+{
+
+// 2 sides to move * 24 pawn squares (files A-D, ranks 2-7) * 64 * 64 king squares
+static constexpr unsigned KPK_SIZE = 2 * 24 * 64 * 64;
+
+enum KPKResult : uint8_t
+{
+    INVALID = 0,
+    UNKNOWN = 1,
+    DRAW = 2,
+    WIN = 4
+};
+
+std::bitset<KPK_SIZE> kpkWins;
+
+/********************
+ * Index layout
+ * bit  0- 5: king square of the pawn side
+ * bit  6-11: king square of the lone king
+ * bit 12   : side to move
+ * bit 13-14: pawn file (A-D)
+ * bit 15-17: RANK_7 - pawn rank
+ *******************/
+unsigned kpkIndex(Color stm, Square bksq, Square wksq, Square psq)
+{
+    return wksq | (bksq << 6) | (stm << 12) | (square_file(psq) << 13) | ((RANK_7 - square_rank(psq)) << 15);
+}
+
+struct KPKPosition
+{
+    Color stm;
+    Square wksq;
+    Square bksq;
+    Square psq;
+
+    KPKPosition(unsigned idx)
+    {
+        wksq = Square(idx & 0x3F);
+        bksq = Square((idx >> 6) & 0x3F);
+        stm = Color((idx >> 12) & 0x01);
+        psq = file_rank_square(File((idx >> 13) & 0x03), Rank(RANK_7 - (idx >> 15)));
+    }
+
+    KPKResult initialResult() const
+    {
+        const U64 pawnAttacks = PawnAttacks(psq, White);
+
+        // Kings touching each other, pieces on the same square or the
+        // lone king in check while the pawn side is to move.
+        if (square_distance(wksq, bksq) <= 1 || wksq == psq || bksq == psq ||
+            (stm == White && (pawnAttacks & (1ULL << bksq))))
+            return INVALID;
+
+        // The pawn can promote without being captured.
+        if (stm == White && square_rank(psq) == RANK_7 && wksq != psq + NORTH &&
+            (square_distance(bksq, psq + NORTH) > 1 || square_distance(wksq, psq + NORTH) == 1))
+            return WIN;
+
+        // Stalemate or the lone king can capture the undefended pawn.
+        if (stm == Black && (!(KingAttacks(bksq) & ~(KingAttacks(wksq) | pawnAttacks)) ||
+                             (KingAttacks(bksq) & ~KingAttacks(wksq) & (1ULL << psq))))
+            return DRAW;
+
+        return UNKNOWN;
+    }
+};
+
+} // namespace
+
+/********************
+ * Retrograde analysis, starting from the won promotions every newly won
+ * position updates its predecessors. A position with the pawn side to move
+ * is won as soon as one successor is won, a position with the lone king to move
+ * once all of its legal successors are won. Everything left over is a draw.
+ *******************/
+void init()
+{
+    std::vector<uint8_t> db(KPK_SIZE);
+    std::vector<uint8_t> undecided(KPK_SIZE);
+    std::vector<unsigned> queue;
+
+    for (unsigned idx = 0; idx < KPK_SIZE; idx++)
+    {
+        db[idx] = KPKPosition(idx).initialResult();
+        if (db[idx] == WIN)
+            queue.emplace_back(idx);
+    }
+
+    // count the legal king moves of the lone king
+    for (unsigned idx = 0; idx < KPK_SIZE; idx++)
+    {
+        const KPKPosition pos(idx);
+        if (pos.stm != Black || db[idx] != UNKNOWN)
+            continue;
+
+        U64 moves = KingAttacks(pos.bksq);
+        while (moves)
+            undecided[idx] += db[kpkIndex(White, poplsb(moves), pos.wksq, pos.psq)] != INVALID;
+    }
+
+    auto markWin = [&](unsigned prev) {
+        if (db[prev] == UNKNOWN)
+        {
+            db[prev] = WIN;
+            queue.emplace_back(prev);
+        }
+    };
+
+    while (queue.size())
+    {
+        const KPKPosition pos(queue.back());
+        queue.pop_back();
+
+        if (pos.stm == White)
+        {
+            // the lone king moved into this position
+            U64 moves = KingAttacks(pos.bksq);
+            while (moves)
+            {
+                const unsigned prev = kpkIndex(Black, poplsb(moves), pos.wksq, pos.psq);
+                if (db[prev] == UNKNOWN && --undecided[prev] == 0)
+                    markWin(prev);
+            }
+        }
+        else
+        {
+            // the king of the pawn side moved into this position
+            U64 moves = KingAttacks(pos.wksq);
+            while (moves)
+                markWin(kpkIndex(White, pos.bksq, poplsb(moves), pos.psq));
+
+            // or the pawn was pushed, illegal origins are INVALID entries
+            const Square from = pos.psq + SOUTH;
+            if (square_rank(pos.psq) >= RANK_3)
+                markWin(kpkIndex(White, pos.bksq, pos.wksq, from));
+
+            if (square_rank(pos.psq) == RANK_4 && from != pos.wksq && from != pos.bksq)
+                markWin(kpkIndex(White, pos.bksq, pos.wksq, from + SOUTH));
+        }
+    }
+
+    for (unsigned idx = 0; idx < KPK_SIZE; idx++)
+        kpkWins[idx] = db[idx] == WIN;
+}
+
+bool probeKPK(Color stm, Square wksq, Square wpsq, Square bksq)
+{
+    // the bitbase only stores pawns on the files A-D
+    if (square_file(wpsq) > FILE_D)
+    {
+        wksq = Square(wksq ^ 7);
+        wpsq = Square(wpsq ^ 7);
+        bksq = Square(bksq ^ 7);
+    }
+
+    return kpkWins[kpkIndex(stm, bksq, wksq, wpsq)];
+}
+
+bool isKPK(const Board &board)
+{
+    return popcount(board.All()) == 3 && board.pieces(PAWN);
+}
+
+bool probe(const Board &board)
+{
+    assert(isKPK(board));
+
+    const Color strong = board.pieces<WhitePawn>() ? White : Black;
+
+    Square wksq = board.KingSQ(strong);
+    Square bksq = board.KingSQ(~strong);
+    Square wpsq = lsb(board.pieces(PAWN, strong));
+    Color stm = board.sideToMove;
+
+    // mirror the board vertically so that the pawn side is white
+    if (strong == Black)
+    {
+        wksq = Square(wksq ^ 56);
+        bksq = Square(bksq ^ 56);
+        wpsq = Square(wpsq ^ 56);
+        stm = ~stm;
+    }
+
+    return probeKPK(stm, wksq, wpsq, bksq);
+}
+
+} // namespace Bitbase
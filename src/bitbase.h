@@ -0,0 +1,29 @@
+#pragma once
+
+#include "board.h"
+
+namespace Bitbase
+{
+
+/// @brief generate the KPK bitbase by retrograde analysis, has to be called once at startup
+void init();
+
+/// @brief probe the KPK bitbase with the pawn side normalized to white
+/// @param stm side to move
+/// @param wksq square of the king of the pawn side
+/// @param wpsq square of the pawn
+/// @param bksq square of the lone king
+/// @return true if the pawn side wins
+bool probeKPK(Color stm, Square wksq, Square wpsq, Square bksq);
+
+/// @brief only both kings and a single pawn are on the board
+/// @param board
+/// @return
+bool isKPK(const Board &board);
+
+/// @brief probe the KPK bitbase, the position has to be a KPK position
+/// @param board
+/// @return true if the side with the pawn wins, otherwise the position is a draw
+bool probe(const Board &board);
+
+} // namespace Bitbase
@@ -44,16 +44,21 @@ void Board::accumulate()
         bool input = p != None;
         if (!input)
             continue;
-        NNUE::activate(accumulator, i, p);
+        NNUE::activate(accumulator, i, p, nnueWeights);
     }
 }
 
 Piece Board::pieceAtBB(Square sq) const
 {
-    for (Piece p = WhitePawn; p < None; p++)
+    const U64 bb = 1ULL << sq;
+
+    if (!(All() & bb))
+        return None;
+
+    for (int pt = PAWN; pt <= KING; pt++)
     {
-        if (piecesBB[p] & (1ULL << sq))
-            return p;
+        if (typesBB[pt] & bb)
+            return makePiece(PieceType(pt), Color(!(colorsBB[White] & bb)));
     }
 
     return None;
@@ -66,10 +71,15 @@ Piece Board::pieceAtB(Square sq) const
 
 void Board::applyFen(const std::string &fen, bool updateAcc)
 {
-    for (Piece p = WhitePawn; p < None; p++)
-    {
-        piecesBB[p] = 0ULL;
-    }
+    for (auto &bb : typesBB)
+        bb = 0ULL;
+
+    colorsBB[White] = colorsBB[Black] = 0ULL;
+    infoValid = false;
+
+    materialKey = 0ULL;
+    pieceCountAll = 0;
+    std::fill(std::begin(pieceCounts), std::end(pieceCounts), 0);
 
     std::vector<std::string> params = splitInput(fen);
 
@@ -174,6 +184,7 @@ void Board::applyFen(const std::string &fen, bool updateAcc)
     accumulatorStack.clear();
 
     hashKey = zobristHash();
+    checkers = findCheckers();
 }
 
 std::string Board::getFen() const
@@ -281,7 +292,7 @@ Result Board::isDrawn(bool inCheck)
         return Result::DRAWN;
     }
 
-    const auto count = popcount(All());
+    const auto count = this->count();
 
     if (count == 2)
         return Result::DRAWN;
@@ -306,7 +317,7 @@ Result Board::isDrawn(bool inCheck)
 
 bool Board::nonPawnMat(Color c) const
 {
-    return pieces(KNIGHT, c) | pieces(BISHOP, c) | pieces(ROOK, c) | pieces(QUEEN, c);
+    return colorsBB[c] & ~(typesBB[PAWN] | typesBB[KING]);
 }
 
 Square Board::KingSQ(Color c) const
@@ -321,13 +332,12 @@ U64 Board::Enemy(Color c) const
 
 U64 Board::Us(Color c) const
 {
-    return piecesBB[PAWN + c * 6] | piecesBB[KNIGHT + c * 6] | piecesBB[BISHOP + c * 6] | piecesBB[ROOK + c * 6] |
-           piecesBB[QUEEN + c * 6] | piecesBB[KING + c * 6];
+    return colorsBB[c];
 }
 
 U64 Board::All() const
 {
-    return Us<White>() | Us<Black>();
+    return colorsBB[White] | colorsBB[Black];
 }
 
 Color Board::colorOf(Square loc) const
@@ -337,64 +347,36 @@ Color Board::colorOf(Square loc) const
 
 bool Board::isSquareAttacked(Color c, Square sq) const
 {
-    if (pieces(PAWN, c) & PawnAttacks(sq, ~c))
-        return true;
-    if (pieces(KNIGHT, c) & KnightAttacks(sq))
-        return true;
-    if ((pieces(BISHOP, c) | pieces(QUEEN, c)) & BishopAttacks(sq, All()))
-        return true;
-    if ((pieces(ROOK, c) | pieces(QUEEN, c)) & RookAttacks(sq, All()))
-        return true;
-    if (pieces(KING, c) & KingAttacks(sq))
-        return true;
-    return false;
+    return isSquareAttacked(c, sq, All());
 }
 
 bool Board::isSquareAttacked(Color c, Square sq, U64 occ) const
 {
-    if (pieces(PAWN, c) & PawnAttacks(sq, ~c))
-        return true;
-    if (pieces(KNIGHT, c) & KnightAttacks(sq))
-        return true;
-    if ((pieces(BISHOP, c) | pieces(QUEEN, c)) & BishopAttacks(sq, occ))
-        return true;
-    if ((pieces(ROOK, c) | pieces(QUEEN, c)) & RookAttacks(sq, occ))
-        return true;
-    if (pieces(KING, c) & KingAttacks(sq))
-        return true;
-    return false;
+    return c == White ? isSquareAttacked<White>(sq, occ) : isSquareAttacked<Black>(sq, occ);
 }
 
-U64 Board::allAttackers(Square sq, U64 occupiedBB)
+U64 Board::allAttackers(Square sq, U64 occupiedBB) const
 {
     return attackersForSide(White, sq, occupiedBB) | attackersForSide(Black, sq, occupiedBB);
 }
 
-U64 Board::attackersForSide(Color attackerColor, Square sq, U64 occupiedBB)
+U64 Board::attackersForSide(Color attackerColor, Square sq, U64 occupiedBB) const
 {
-    U64 attackingBishops = pieces(BISHOP, attackerColor);
-    U64 attackingRooks = pieces(ROOK, attackerColor);
-    U64 attackingQueens = pieces(QUEEN, attackerColor);
-    U64 attackingKnights = pieces(KNIGHT, attackerColor);
-    U64 attackingKing = pieces(KING, attackerColor);
-    U64 attackingPawns = pieces(PAWN, attackerColor);
-
-    U64 interCardinalRays = BishopAttacks(sq, occupiedBB);
-    U64 cardinalRaysRays = RookAttacks(sq, occupiedBB);
-
-    U64 attackers = interCardinalRays & (attackingBishops | attackingQueens);
-    attackers |= cardinalRaysRays & (attackingRooks | attackingQueens);
-    attackers |= KnightAttacks(sq) & attackingKnights;
-    attackers |= KingAttacks(sq) & attackingKing;
-    attackers |= PawnAttacks(sq, ~attackerColor) & attackingPawns;
-    return attackers;
+    U64 attackers = BishopAttacks(sq, occupiedBB) & (typesBB[BISHOP] | typesBB[QUEEN]);
+    attackers |= RookAttacks(sq, occupiedBB) & (typesBB[ROOK] | typesBB[QUEEN]);
+    attackers |= KnightAttacks(sq) & typesBB[KNIGHT];
+    attackers |= KingAttacks(sq) & typesBB[KING];
+    attackers |= PawnAttacks(sq, ~attackerColor) & typesBB[PAWN];
+    return attackers & colorsBB[attackerColor];
 }
 
 void Board::makeNullMove()
 {
     stateHistory.emplace_back(enPassantSquare, castlingRights, halfMoveClock, None, castlingRights960White,
-                              castlingRights960Black);
+                              castlingRights960Black, checkers);
     sideToMove = ~sideToMove;
+    checkers = findCheckers();
+    infoValid = false;
 
     // Update the hash key
     hashKey ^= updateKeySideToMove();
@@ -418,6 +400,7 @@ void Board::unmakeNullMove()
     halfMoveClock = restore.halfMove;
     castlingRights960White = restore.chess960White;
     castlingRights960Black = restore.chess960Black;
+    checkers = restore.checkers;
 
     hashKey ^= updateKeySideToMove();
     if (enPassantSquare != NO_SQ)
@@ -425,6 +408,7 @@ void Board::unmakeNullMove()
 
     fullMoveNumber--;
     sideToMove = ~sideToMove;
+    infoValid = false;
 }
 
 const NNUE::accumulator &Board::getAccumulator() const
@@ -434,6 +418,14 @@ const NNUE::accumulator &Board::getAccumulator() const
 
 bool Board::isLegal(const Move move)
 {
+    if (!infoValid)
+    {
+        if (sideToMove == White)
+            Movegen::init<White>(*this, KingSQ(White));
+        else
+            Movegen::init<Black>(*this, KingSQ(Black));
+    }
+
     const Color color = sideToMove;
     const Square from_sq = from(move);
     const Square to_sq = to(move);
@@ -441,7 +433,7 @@ bool Board::isLegal(const Move move)
     const Piece capture = pieceAtB(to_sq);
     const U64 all = All();
 
-    Square kSQ = KingSQ(color);
+    const Square kSQ = KingSQ(color);
 
     assert(type_of_piece(capture) != KING);
 
@@ -466,68 +458,30 @@ bool Board::isLegal(const Move move)
     {
         const Square destKing = file_rank_square(to_sq > from_sq ? FILE_G : FILE_C, square_rank(from_sq));
         const Square rookToSq = file_rank_square(to_sq > from_sq ? FILE_F : FILE_D, square_rank(from_sq));
-        const Piece rook = sideToMove == White ? WhiteRook : BlackRook;
 
         if (isSquareAttacked(~color, from_sq, all) || isSquareAttacked(~color, destKing, all))
             return false;
 
-        piecesBB[p] &= ~(1ull << from_sq);
-        piecesBB[rook] &= ~(1ull << to_sq);
-
-        piecesBB[p] |= (1ull << destKing);
-        piecesBB[rook] |= (1ull << rookToSq);
-
-        bool isAttacked = isSquareAttacked(~color, destKing);
-
-        piecesBB[rook] &= ~(1ull << rookToSq);
-        piecesBB[p] &= ~(1ull << destKing);
+        // occupancy after the king and the rook moved
+        const U64 occ = (all ^ (1ull << from_sq) ^ (1ull << to_sq)) | (1ull << destKing) | (1ull << rookToSq);
 
-        piecesBB[p] |= (1ull << from_sq);
-        piecesBB[rook] |= (1ull << to_sq);
-
-        return !isAttacked;
-
-        assert(All() == all);
-        return true;
+        return !attackersForSide(~color, destKing, occ);
     }
 
     if (piece(move) == KING)
-    {
-        kSQ = to_sq;
-    }
+        return !(seen & (1ull << to_sq));
 
-    if (promoted(move))
-    {
-        piecesBB[makePiece(PAWN, color)] &= ~(1ull << from_sq);
-        piecesBB[p] |= (1ull << to_sq);
-    }
-    else
-    {
-        piecesBB[p] &= ~(1ull << from_sq);
-        piecesBB[p] |= (1ull << to_sq);
-    }
+    if (doubleCheck == 2)
+        return false;
 
-    if (capture != None)
-        piecesBB[capture] &= ~(1ull << to_sq);
+    // unpinned pieces only have to resolve a check
+    if (!((pinHV | pinD) & (1ull << from_sq)))
+        return checkMask & (1ull << to_sq);
 
-    const bool isAttacked = isSquareAttacked(~color, kSQ);
+    // occupancy after the move, a captured piece does not attack anymore
+    const U64 occ = (all ^ (1ull << from_sq)) | (1ull << to_sq);
 
-    if (capture != None)
-        piecesBB[capture] |= (1ull << to_sq);
-
-    if (promoted(move))
-    {
-        piecesBB[p] &= ~(1ull << to_sq);
-        piecesBB[makePiece(PAWN, color)] |= (1ull << from_sq);
-    }
-    else
-    {
-        piecesBB[p] |= (1ull << from_sq);
-        piecesBB[p] &= ~(1ull << to_sq);
-    }
-
-    assert(All() == all);
-    return !isAttacked;
+    return !(attackersForSide(~color, kSQ, occ) & ~(1ull << to_sq));
 }
 
 bool Board::isPseudoLegal(const Move move)
@@ -714,57 +668,76 @@ U64 Board::attacksByPiece(PieceType pt, Square sq, Color c, U64 occ)
 /********************
  * Static Exchange Evaluation, logical based on Weiss (https://github.com/TerjeKir/weiss) licensed under GPL-3.0
  *******************/
-bool Board::see(Move move, int threshold)
+bool Board::see(Move move, int threshold) const
 {
-    Square from_sq = from(move);
-    Square to_sq = to(move);
-    PieceType attacker = type_of_piece(pieceAtB(from_sq));
-    PieceType victim = type_of_piece(pieceAtB(to_sq));
+    return colorOf(from(move)) == White ? see<White>(move, threshold) : see<Black>(move, threshold);
+}
+
+template <Color us> bool Board::see(Move move, int threshold) const
+{
+    const Square from_sq = from(move);
+    const Square to_sq = to(move);
+    const PieceType attacker = type_of_piece(pieceAtB(from_sq));
+    const PieceType victim = type_of_piece(pieceAtB(to_sq));
+
     int swap = pieceValuesDefault[victim] - threshold;
     if (swap < 0)
         return false;
+
     swap -= pieceValuesDefault[attacker];
     if (swap >= 0)
         return true;
-    U64 occ = (All() ^ (1ULL << from_sq)) | (1ULL << to_sq);
-    U64 attackers = allAttackers(to_sq, occ) & occ;
 
-    U64 queens = piecesBB[WhiteQueen] | piecesBB[BlackQueen];
+    // the board does not change during the exchange, the slider sets are gathered once
+    const U64 bishops = typesBB[BISHOP] | typesBB[QUEEN];
+    const U64 rooks = typesBB[ROOK] | typesBB[QUEEN];
 
-    U64 bishops = piecesBB[WhiteBishop] | piecesBB[BlackBishop] | queens;
-    U64 rooks = piecesBB[WhiteRook] | piecesBB[BlackRook] | queens;
+    U64 occ = (All() ^ (1ULL << from_sq)) | (1ULL << to_sq);
 
-    Color sT = ~colorOf(from_sq);
+    // clang-format off
+    U64 attackers = ((BishopAttacks(to_sq, occ) & bishops)
+                  |  (RookAttacks(to_sq, occ) & rooks)
+                  |  (KnightAttacks(to_sq) & typesBB[KNIGHT])
+                  |  (KingAttacks(to_sq) & typesBB[KING])
+                  |  (PawnAttacks(to_sq, Black) & pieces<WhitePawn>())
+                  |  (PawnAttacks(to_sq, White) & pieces<BlackPawn>())) & occ;
+    // clang-format on
+
+    Color sT = ~us;
 
     while (true)
     {
         attackers &= occ;
-        U64 myAttackers = attackers & Us(sT);
+        const U64 myAttackers = attackers & colorsBB[sT];
         if (!myAttackers)
             break;
 
+        // least valuable attacker
         int pt;
-        for (pt = 0; pt <= 5; pt++)
+        for (pt = PAWN; pt < KING; pt++)
         {
-            if (myAttackers & (piecesBB[pt] | piecesBB[pt + 6]))
+            if (myAttackers & typesBB[pt])
                 break;
         }
+
         sT = ~sT;
         if ((swap = -swap - 1 - piece_values[MG][pt]) >= 0)
         {
-            if (pt == KING && (attackers & Us(sT)))
+            if (pt == KING && (attackers & colorsBB[sT]))
                 sT = ~sT;
             break;
         }
 
-        occ ^= (1ULL << (lsb(myAttackers & (piecesBB[pt] | piecesBB[pt + 6]))));
+        occ ^= 1ULL << lsb(myAttackers & typesBB[pt]);
 
+        // add the x-ray attackers behind the removed piece
         if (pt == PAWN || pt == BISHOP || pt == QUEEN)
             attackers |= BishopAttacks(to_sq, occ) & bishops;
         if (pt == ROOK || pt == QUEEN)
             attackers |= RookAttacks(to_sq, occ) & rooks;
     }
-    return sT != colorOf(from_sq);
+
+    return sT != us;
 }
 
 void Board::clearStacks()
@@ -804,6 +777,21 @@ std::ostream &operator<<(std::ostream &os, const Board &b)
     return os;
 }
 
+U64 Board::materialHash() const
+{
+    U64 key = 0ULL;
+
+    for (Piece p = WhitePawn; p < None; p = Piece(p + 1))
+    {
+        const int n = popcount(pieces(type_of_piece(p), Color(p / 6)));
+
+        for (int i = 0; i < n; i++)
+            key ^= materialKeys[p][i];
+    }
+
+    return key;
+}
+
 U64 Board::zobristHash() const
 {
     U64 hash = 0ULL;
@@ -834,6 +822,32 @@ U64 Board::zobristHash() const
     return hash ^ cast_hash ^ turn_hash ^ ep_hash;
 }
 
+U64 Board::keyAfter(Move move) const
+{
+    const Square from_sq = from(move);
+    const Square to_sq = to(move);
+    const Piece p = makePiece(piece(move), sideToMove);
+    const Piece capture = board[to_sq];
+
+    U64 key = hashKey ^ updateKeySideToMove();
+
+    if (enPassantSquare != NO_SQ)
+    {
+        key ^= updateKeyEnPassant(enPassantSquare);
+
+        if (to_sq == enPassantSquare && piece(move) == PAWN)
+            key ^= updateKeyPiece(makePiece(PAWN, ~sideToMove), Square(to_sq - (sideToMove * -2 + 1) * 8));
+    }
+
+    if (capture != None)
+        key ^= updateKeyPiece(capture, to_sq);
+
+    key ^= updateKeyPiece(promoted(move) ? makePiece(PAWN, sideToMove) : p, from_sq);
+    key ^= updateKeyPiece(p, to_sq);
+
+    return key;
+}
+
 /**
  * PRIVATE FUNCTIONS
  *
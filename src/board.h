@@ -26,10 +26,12 @@ struct State
     Piece capturedPiece = None;
     std::array<File, 2> chess960White = {};
     std::array<File, 2> chess960Black = {};
+    U64 checkers = 0;
     State(Square enpassantCopy = {}, uint8_t castlingRightsCopy = {}, uint8_t halfMoveCopy = {},
-          Piece capturedPieceCopy = None, std::array<File, 2> c960W = {NO_FILE}, std::array<File, 2> c960B = {NO_FILE})
+          Piece capturedPieceCopy = None, std::array<File, 2> c960W = {NO_FILE}, std::array<File, 2> c960B = {NO_FILE},
+          U64 checkersCopy = 0)
         : enPassant(enpassantCopy), castling(castlingRightsCopy), halfMove(halfMoveCopy),
-          capturedPiece(capturedPieceCopy), chess960White(c960W), chess960Black(c960B)
+          capturedPiece(capturedPieceCopy), chess960White(c960W), chess960Black(c960B), checkers(checkersCopy)
     {
     }
 };
@@ -65,6 +67,10 @@ class Board
     // repetition detection
     std::vector<U64> hashHistory;
 
+    // enemy pieces that give check to the king of the side to move,
+    // updated in makeMove and restored from the state history
+    U64 checkers = 0;
+
     // keeps track on how many checks there currently are
     // 2 = only king moves are valid
     // 1 = king move, block/capture
@@ -93,16 +99,34 @@ class Board
     U64 occAll;
     U64 enemyEmptyBB;
 
+    // the masks above belong to the current position, they are computed once
+    // by Movegen::init and reset whenever the position changes
+    bool infoValid = false;
+
     // current hashkey
     U64 hashKey;
 
+    // zobrist key of the piece counts, updated in placePiece and removePiece
+    U64 materialKey = 0;
+
+    // number of pieces of every kind and of all pieces
+    uint8_t pieceCounts[12] = {};
+    uint8_t pieceCountAll = 0;
+
     std::array<std::array<U64, MAX_SQ>, MAX_SQ> SQUARES_BETWEEN_BB;
 
     std::vector<State> stateHistory;
 
-    U64 piecesBB[12] = {};
+    // a piece bitboard is the intersection of its type and its color bitboard
+    U64 typesBB[6] = {};
+    U64 colorsBB[2] = {};
+
     Piece board[MAX_SQ];
 
+    // input weights used for the accumulator updates,
+    // search threads bound to a numa node use a node local copy
+    const int16_t *nnueWeights = inputWeights;
+
     /// @brief constructor for the board, loads startpos and initializes SQUARES_BETWEEN_BB array
     Board();
 
@@ -147,8 +171,7 @@ class Board
     U64 Us(Color c) const;
     template <Color c> U64 Us() const
     {
-        return piecesBB[PAWN + c * 6] | piecesBB[KNIGHT + c * 6] | piecesBB[BISHOP + c * 6] | piecesBB[ROOK + c * 6] |
-               piecesBB[QUEEN + c * 6] | piecesBB[KING + c * 6];
+        return colorsBB[c];
     }
 
     U64 All() const;
@@ -157,17 +180,25 @@ class Board
 
     template <Piece p> constexpr U64 pieces() const
     {
-        return piecesBB[p];
+        return typesBB[type_of_piece(p)] & colorsBB[p / 6];
     }
 
     template <PieceType p, Color c> constexpr U64 pieces() const
     {
-        return piecesBB[p + c * 6];
+        return typesBB[p] & colorsBB[c];
     }
 
     constexpr U64 pieces(PieceType p, Color c) const
     {
-        return piecesBB[p + c * 6];
+        return typesBB[p] & colorsBB[c];
+    }
+
+    /// @brief pieces of a type of both colors
+    /// @param p
+    /// @return
+    constexpr U64 pieces(PieceType p) const
+    {
+        return typesBB[p];
     }
 
     /// @brief returns the color of a piece at a square
@@ -188,9 +219,23 @@ class Board
     /// @return
     bool isSquareAttacked(Color c, Square sq, U64 occ) const;
 
+    /// @brief is square attacked by color c, the attacker color is known at compile time
+    /// @tparam c
+    /// @param sq
+    /// @param occ
+    /// @return
+    template <Color c> bool isSquareAttacked(Square sq, U64 occ) const;
+
+    /// @brief is the side to move in check
+    /// @return
+    bool inCheck() const
+    {
+        return checkers;
+    }
+
     // attackers used for SEE
-    U64 allAttackers(Square sq, U64 occupiedBB);
-    U64 attackersForSide(Color attackerColor, Square sq, U64 occupiedBB);
+    U64 allAttackers(Square sq, U64 occupiedBB) const;
+    U64 attackersForSide(Color attackerColor, Square sq, U64 occupiedBB) const;
 
     /// @brief plays the move on the internal board
     /// @tparam updateNNUE update true = update nnue
@@ -231,6 +276,10 @@ class Board
     /// @param toSq
     template <bool updateNNUE> void movePiece(Piece piece, Square fromSq, Square toSq);
 
+    /// @brief legality of a pseudo legal move, computes the check and pin masks
+    /// of the position if they are not known yet
+    /// @param move
+    /// @return
     bool isLegal(const Move move);
 
     bool isPseudoLegal(const Move move);
@@ -242,7 +291,10 @@ class Board
     /********************
      * Static Exchange Evaluation, logical based on Weiss (https://github.com/TerjeKir/weiss) licensed under GPL-3.0
      *******************/
-    bool see(Move move, int threshold);
+    bool see(Move move, int threshold) const;
+
+    /// @brief SEE for a move of color us
+    template <Color us> bool see(Move move, int threshold) const;
 
     void clearStacks();
 
@@ -252,6 +304,32 @@ class Board
     /// @return
     U64 zobristHash() const;
 
+    /// @brief calculate the material key from scratch
+    /// @return
+    U64 materialHash() const;
+
+    /// @brief number of pieces of a kind
+    /// @param p
+    /// @return
+    int count(Piece p) const
+    {
+        return pieceCounts[p];
+    }
+
+    /// @brief number of pieces on the board, kings included
+    /// @return
+    int count() const
+    {
+        return pieceCountAll;
+    }
+
+    /// @brief hash key of the position after the move, cheap enough to prefetch the TT entry
+    /// before the move is made. Changes of the castling rights and new en passant squares
+    /// are ignored, the key only differs from the real one after these moves.
+    /// @param move
+    /// @return
+    U64 keyAfter(Move move) const;
+
   private:
     /// @brief current accumulator
     NNUE::accumulator accumulator;
@@ -269,46 +347,122 @@ class Board
     U64 updateKeyEnPassant(Square sq) const;
     U64 updateKeySideToMove() const;
 
+    /// @brief enemy pieces attacking the king of the side to move
+    /// @return
+    U64 findCheckers() const;
+
     void removeCastlingRightsAll(Color c);
     void removeCastlingRightsRook(Square sq);
+
+    /// @brief makeMove and unmakeMove for the moving color c,
+    /// the public versions dispatch on the side to move once
+    template <bool updateNNUE, Color c> void makeMove(Move move);
+    template <bool updateNNUE, Color c> void unmakeMove(Move move);
 };
 
+template <Color c> bool Board::isSquareAttacked(Square sq, U64 occ) const
+{
+    const U64 us = colorsBB[c];
+
+    if (typesBB[PAWN] & us & PawnAttacks(sq, ~c))
+        return true;
+    if (typesBB[KNIGHT] & us & KnightAttacks(sq))
+        return true;
+    if ((typesBB[BISHOP] | typesBB[QUEEN]) & us & BishopAttacks(sq, occ))
+        return true;
+    if ((typesBB[ROOK] | typesBB[QUEEN]) & us & RookAttacks(sq, occ))
+        return true;
+    if (typesBB[KING] & us & KingAttacks(sq))
+        return true;
+    return false;
+}
+
+inline U64 Board::findCheckers() const
+{
+    const Square kSQ = KingSQ(sideToMove);
+    const U64 occ = All();
+
+    return ((PawnAttacks(kSQ, sideToMove) & typesBB[PAWN]) | (KnightAttacks(kSQ) & typesBB[KNIGHT]) |
+            (BishopAttacks(kSQ, occ) & (typesBB[BISHOP] | typesBB[QUEEN])) |
+            (RookAttacks(kSQ, occ) & (typesBB[ROOK] | typesBB[QUEEN]))) &
+           colorsBB[~sideToMove];
+}
+
 template <bool updateNNUE> void Board::removePiece(Piece piece, Square sq)
 {
-    piecesBB[piece] &= ~(1ULL << sq);
+    typesBB[type_of_piece(piece)] &= ~(1ULL << sq);
+    colorsBB[piece / 6] &= ~(1ULL << sq);
     board[sq] = None;
+
+    assert(pieceCounts[piece] > 0);
+    materialKey ^= materialKeys[piece][--pieceCounts[piece]];
+    pieceCountAll--;
+
     if constexpr (updateNNUE)
     {
-        NNUE::deactivate(accumulator, sq, piece);
+        NNUE::deactivate(accumulator, sq, piece, nnueWeights);
     }
 }
 
 template <bool updateNNUE> void Board::placePiece(Piece piece, Square sq)
 {
-    piecesBB[piece] |= (1ULL << sq);
+    typesBB[type_of_piece(piece)] |= (1ULL << sq);
+    colorsBB[piece / 6] |= (1ULL << sq);
     board[sq] = piece;
+
+    materialKey ^= materialKeys[piece][pieceCounts[piece]++];
+    pieceCountAll++;
+
     if constexpr (updateNNUE)
     {
-        NNUE::activate(accumulator, sq, piece);
+        NNUE::activate(accumulator, sq, piece, nnueWeights);
     }
 }
 
 template <bool updateNNUE> void Board::movePiece(Piece piece, Square fromSq, Square toSq)
 {
-    piecesBB[piece] &= ~(1ULL << fromSq);
-    piecesBB[piece] |= (1ULL << toSq);
+    const U64 fromTo = (1ULL << fromSq) | (1ULL << toSq);
+    typesBB[type_of_piece(piece)] ^= fromTo;
+    colorsBB[piece / 6] ^= fromTo;
     board[fromSq] = None;
     board[toSq] = piece;
     if constexpr (updateNNUE)
     {
-        NNUE::move(accumulator, fromSq, toSq, piece);
+        NNUE::move(accumulator, fromSq, toSq, piece, nnueWeights);
     }
 }
 
 template <bool updateNNUE> void Board::makeMove(Move move)
 {
+    if (sideToMove == White)
+        makeMove<updateNNUE, White>(move);
+    else
+        makeMove<updateNNUE, Black>(move);
+}
+
+template <bool updateNNUE> void Board::unmakeMove(Move move)
+{
+    // the side to move is the opponent of the side that made the move
+    if (sideToMove == Black)
+        unmakeMove<updateNNUE, White>(move);
+    else
+        unmakeMove<updateNNUE, Black>(move);
+}
+
+template <bool updateNNUE, Color c> void Board::makeMove(Move move)
+{
+    // clang-format off
+    constexpr Piece ourKing   = c == White ? WhiteKing : BlackKing;
+    constexpr Piece ourRook   = c == White ? WhiteRook : BlackRook;
+    constexpr Piece ourPawn   = c == White ? WhitePawn : BlackPawn;
+    constexpr Piece theirPawn = c == White ? BlackPawn : WhitePawn;
+    constexpr int   up        = c == White ? NORTH : -NORTH;
+    // clang-format on
+
+    assert(sideToMove == c);
+
     PieceType pt = piece(move);
-    Piece p = makePiece(pt, sideToMove);
+    Piece p = Piece(pt + 6 * c);
     Square from_sq = from(move);
     Square to_sq = to(move);
     Piece capture = board[to_sq];
@@ -324,7 +478,7 @@ template <bool updateNNUE> void Board::makeMove(Move move)
     // *****************************
 
     stateHistory.emplace_back(enPassantSquare, castlingRights, halfMoveClock, capture, castlingRights960White,
-                              castlingRights960Black);
+                              castlingRights960Black, checkers);
 
     if constexpr (updateNNUE)
         accumulatorStack.emplace_back(accumulator);
@@ -333,10 +487,7 @@ template <bool updateNNUE> void Board::makeMove(Move move)
     fullMoveNumber++;
 
     bool ep = to_sq == enPassantSquare;
-    const bool isCastlingWhite =
-        (p == WhiteKing && capture == WhiteRook) || (p == WhiteKing && square_distance(to_sq, from_sq) >= 2);
-    const bool isCastlingBlack =
-        (p == BlackKing && capture == BlackRook) || (p == BlackKing && square_distance(to_sq, from_sq) >= 2);
+    const bool isCastling = p == ourKing && (capture == ourRook || square_distance(to_sq, from_sq) >= 2);
 
     // *****************************
     // UPDATE HASH
@@ -350,19 +501,23 @@ template <bool updateNNUE> void Board::makeMove(Move move)
 
     hashKey ^= updateKeyCastling();
 
-    if (isCastlingWhite || isCastlingBlack)
+    if (isCastling)
     {
-        Piece rook = sideToMove == White ? WhiteRook : BlackRook;
         Square rookSQ = file_rank_square(to_sq > from_sq ? FILE_F : FILE_D, square_rank(from_sq));
+        Square kingSQ = file_rank_square(to_sq > from_sq ? FILE_G : FILE_C, square_rank(from_sq));
 
         assert(type_of_piece(pieceAtB(to_sq)) == ROOK);
-        hashKey ^= updateKeyPiece(rook, to_sq);
-        hashKey ^= updateKeyPiece(rook, rookSQ);
+        hashKey ^= updateKeyPiece(ourRook, to_sq);
+        hashKey ^= updateKeyPiece(ourRook, rookSQ);
+
+        // the move is encoded as king takes rook, the king ends on kingSQ
+        hashKey ^= updateKeyPiece(p, from_sq);
+        hashKey ^= updateKeyPiece(p, kingSQ);
     }
 
     if (pt == KING)
     {
-        removeCastlingRightsAll(sideToMove);
+        removeCastlingRightsAll(c);
     }
     else if (pt == ROOK)
     {
@@ -373,14 +528,14 @@ template <bool updateNNUE> void Board::makeMove(Move move)
         halfMoveClock = 0;
         if (ep)
         {
-            hashKey ^= updateKeyPiece(makePiece(PAWN, ~sideToMove), Square(to_sq - (sideToMove * -2 + 1) * 8));
+            hashKey ^= updateKeyPiece(theirPawn, Square(to_sq - up));
         }
         else if (std::abs(from_sq - to_sq) == 16)
         {
-            U64 epMask = PawnAttacks(Square(to_sq - (sideToMove * -2 + 1) * 8), sideToMove);
-            if (epMask & pieces(PAWN, ~sideToMove))
+            U64 epMask = PawnAttacks(Square(to_sq - up), c);
+            if (epMask & pieces<PAWN, ~c>())
             {
-                enPassantSquare = Square(to_sq - (sideToMove * -2 + 1) * 8);
+                enPassantSquare = Square(to_sq - up);
                 hashKey ^= updateKeyEnPassant(enPassantSquare);
 
                 assert(pieceAtB(enPassantSquare) == None);
@@ -388,7 +543,7 @@ template <bool updateNNUE> void Board::makeMove(Move move)
         }
     }
 
-    if (capture != None && !(isCastlingWhite || isCastlingBlack))
+    if (capture != None && !isCastling)
     {
         halfMoveClock = 0;
         hashKey ^= updateKeyPiece(capture, to_sq);
@@ -400,10 +555,10 @@ template <bool updateNNUE> void Board::makeMove(Move move)
     {
         halfMoveClock = 0;
 
-        hashKey ^= updateKeyPiece(makePiece(PAWN, sideToMove), from_sq);
+        hashKey ^= updateKeyPiece(ourPawn, from_sq);
         hashKey ^= updateKeyPiece(p, to_sq);
     }
-    else
+    else if (!isCastling)
     {
         hashKey ^= updateKeyPiece(p, from_sq);
         hashKey ^= updateKeyPiece(p, to_sq);
@@ -412,33 +567,30 @@ template <bool updateNNUE> void Board::makeMove(Move move)
     hashKey ^= updateKeySideToMove();
     hashKey ^= updateKeyCastling();
 
-    TTable.prefetchTT(hashKey);
-
     // *****************************
     // UPDATE PIECES AND NNUE
     // *****************************
 
-    if (isCastlingWhite || isCastlingBlack)
+    if (isCastling)
     {
         Square rookToSq;
-        Piece rook = sideToMove == White ? WhiteRook : BlackRook;
 
         removePiece<updateNNUE>(p, from_sq);
-        removePiece<updateNNUE>(rook, to_sq);
+        removePiece<updateNNUE>(ourRook, to_sq);
 
         rookToSq = file_rank_square(to_sq > from_sq ? FILE_F : FILE_D, square_rank(from_sq));
         to_sq = file_rank_square(to_sq > from_sq ? FILE_G : FILE_C, square_rank(from_sq));
 
         placePiece<updateNNUE>(p, to_sq);
-        placePiece<updateNNUE>(rook, rookToSq);
+        placePiece<updateNNUE>(ourRook, rookToSq);
     }
     else if (pt == PAWN && ep)
     {
-        assert(pieceAtB(Square(to_sq - (sideToMove * -2 + 1) * 8)) != None);
+        assert(pieceAtB(Square(to_sq - up)) != None);
 
-        removePiece<updateNNUE>(makePiece(PAWN, ~sideToMove), Square(to_sq - (sideToMove * -2 + 1) * 8));
+        removePiece<updateNNUE>(theirPawn, Square(to_sq - up));
     }
-    else if (capture != None && !(isCastlingWhite || isCastlingBlack))
+    else if (capture != None)
     {
         assert(pieceAtB(to_sq) != None);
 
@@ -449,21 +601,34 @@ template <bool updateNNUE> void Board::makeMove(Move move)
     {
         assert(pieceAtB(to_sq) == None);
 
-        removePiece<updateNNUE>(makePiece(PAWN, sideToMove), from_sq);
+        removePiece<updateNNUE>(ourPawn, from_sq);
         placePiece<updateNNUE>(p, to_sq);
     }
-    else if (!(isCastlingWhite || isCastlingBlack))
+    else if (!isCastling)
     {
         assert(pieceAtB(to_sq) == None);
 
         movePiece<updateNNUE>(p, from_sq, to_sq);
     }
 
-    sideToMove = ~sideToMove;
+    sideToMove = ~c;
+
+    checkers = findCheckers();
+    infoValid = false;
 }
 
-template <bool updateNNUE> void Board::unmakeMove(Move move)
+template <bool updateNNUE, Color c> void Board::unmakeMove(Move move)
 {
+    // clang-format off
+    constexpr Piece ourKing   = c == White ? WhiteKing : BlackKing;
+    constexpr Piece ourRook   = c == White ? WhiteRook : BlackRook;
+    constexpr Piece ourPawn   = c == White ? WhitePawn : BlackPawn;
+    constexpr Piece theirPawn = c == White ? BlackPawn : WhitePawn;
+    constexpr int   up        = c == White ? NORTH : -NORTH;
+    // clang-format on
+
+    assert(sideToMove == ~c);
+
     const State restore = stateHistory.back();
     stateHistory.pop_back();
 
@@ -482,6 +647,8 @@ template <bool updateNNUE> void Board::unmakeMove(Move move)
     Piece capture = restore.capturedPiece;
     castlingRights960White = restore.chess960White;
     castlingRights960Black = restore.chess960Black;
+    checkers = restore.checkers;
+    infoValid = false;
 
     fullMoveNumber--;
 
@@ -489,33 +656,29 @@ template <bool updateNNUE> void Board::unmakeMove(Move move)
     Square to_sq = to(move);
     bool promotion = promoted(move);
 
-    sideToMove = ~sideToMove;
+    sideToMove = c;
     PieceType pt = piece(move);
-    Piece p = makePiece(pt, sideToMove);
+    Piece p = Piece(pt + 6 * c);
 
-    const bool isCastlingWhite =
-        (p == WhiteKing && capture == WhiteRook) || (p == WhiteKing && square_distance(to_sq, from_sq) >= 2);
-    const bool isCastlingBlack =
-        (p == BlackKing && capture == BlackRook) || (p == BlackKing && square_distance(to_sq, from_sq) >= 2);
+    const bool isCastling = p == ourKing && (capture == ourRook || square_distance(to_sq, from_sq) >= 2);
 
-    if ((isCastlingWhite || isCastlingBlack))
+    if (isCastling)
     {
         Square rookToSq = to_sq;
-        Piece rook = sideToMove == White ? WhiteRook : BlackRook;
         Square rookFromSq = file_rank_square(to_sq > from_sq ? FILE_F : FILE_D, square_rank(from_sq));
         to_sq = file_rank_square(to_sq > from_sq ? FILE_G : FILE_C, square_rank(from_sq));
 
         // We need to remove both pieces first and then place them back.
-        removePiece<updateNNUE>(rook, rookFromSq);
+        removePiece<updateNNUE>(ourRook, rookFromSq);
         removePiece<updateNNUE>(p, to_sq);
 
         placePiece<updateNNUE>(p, from_sq);
-        placePiece<updateNNUE>(rook, rookToSq);
+        placePiece<updateNNUE>(ourRook, rookToSq);
     }
     else if (promotion)
     {
         removePiece<updateNNUE>(p, to_sq);
-        placePiece<updateNNUE>(makePiece(PAWN, sideToMove), from_sq);
+        placePiece<updateNNUE>(ourPawn, from_sq);
         if (capture != None)
             placePiece<updateNNUE>(capture, to_sq);
         return;
@@ -527,10 +690,9 @@ template <bool updateNNUE> void Board::unmakeMove(Move move)
 
     if (to_sq == enPassantSquare && pt == PAWN)
     {
-        int8_t offset = sideToMove == White ? -8 : 8;
-        placePiece<updateNNUE>(makePiece(PAWN, ~sideToMove), Square(enPassantSquare + offset));
+        placePiece<updateNNUE>(theirPawn, Square(enPassantSquare - up));
     }
-    else if (capture != None && !(isCastlingWhite || isCastlingBlack))
+    else if (capture != None && !isCastling)
     {
         placePiece<updateNNUE>(capture, to_sq);
     }
@@ -0,0 +1,235 @@
+#include "book.h"
+#include "movegen.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// key (8), move (2), weight (2), learn (4)
+static constexpr size_t ENTRY_SIZE = 16;
+
+PolyglotBook::~PolyglotBook()
+{
+    close();
+}
+
+bool PolyglotBook::open(const std::string &path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < LONGLONG(ENTRY_SIZE))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mapHandle = mapping;
+    mappedSize = size_t(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size < off_t(ENTRY_SIZE))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *view = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+        return false;
+
+    mappedSize = size_t(st.st_size);
+#endif
+
+    data = static_cast<const unsigned char *>(view);
+    entryCount = mappedSize / ENTRY_SIZE;
+
+    return true;
+}
+
+void PolyglotBook::close()
+{
+    if (!data)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapHandle);
+    CloseHandle(fileHandle);
+    mapHandle = fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char *>(data), mappedSize);
+#endif
+
+    data = nullptr;
+    entryCount = mappedSize = 0;
+}
+
+bool PolyglotBook::isOpen() const
+{
+    return data != nullptr;
+}
+
+Move PolyglotBook::probe(const Board &board, bool bestMove)
+{
+    if (!data)
+        return NO_MOVE;
+
+    const U64 key = polyglotKey(board);
+
+    size_t first = lowerBound(key);
+    size_t last = first;
+    uint32_t totalWeight = 0;
+
+    while (last < entryCount && readKey(last) == key)
+        totalWeight += readWeight(last++);
+
+    if (first == last)
+        return NO_MOVE;
+
+    size_t chosen = first;
+
+    if (bestMove)
+    {
+        // the first of the moves with the highest weight
+        for (size_t i = first + 1; i < last; i++)
+        {
+            if (readWeight(i) > readWeight(chosen))
+                chosen = i;
+        }
+    }
+    else if (totalWeight > 0)
+    {
+        std::uniform_int_distribution<uint32_t> dist(0, totalWeight - 1);
+        uint32_t pick = dist(generator);
+
+        for (; chosen < last; chosen++)
+        {
+            if (pick < readWeight(chosen))
+                break;
+            pick -= readWeight(chosen);
+        }
+    }
+
+    return toMove(board, readMove(chosen));
+}
+
+U64 PolyglotBook::polyglotKey(const Board &board)
+{
+    U64 key = board.hashKey;
+
+    // polyglot only hashes en passant if a pawn of the side to move can capture
+    const Square ep = board.enPassantSquare;
+    if (ep != NO_SQ && !(PawnAttacks(ep, ~board.sideToMove) & board.pieces(PAWN, board.sideToMove)))
+        key ^= RANDOM_ARRAY[772 + square_file(ep)];
+
+    return key;
+}
+
+size_t PolyglotBook::lowerBound(U64 key) const
+{
+    size_t low = 0;
+    size_t high = entryCount;
+
+    while (low < high)
+    {
+        const size_t mid = low + (high - low) / 2;
+
+        if (readKey(mid) < key)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+U64 PolyglotBook::readKey(size_t index) const
+{
+    const unsigned char *p = data + index * ENTRY_SIZE;
+    U64 key = 0;
+
+    for (int i = 0; i < 8; i++)
+        key = (key << 8) | p[i];
+
+    return key;
+}
+
+uint16_t PolyglotBook::readMove(size_t index) const
+{
+    const unsigned char *p = data + index * ENTRY_SIZE + 8;
+    return uint16_t(p[0] << 8 | p[1]);
+}
+
+uint16_t PolyglotBook::readWeight(size_t index) const
+{
+    const unsigned char *p = data + index * ENTRY_SIZE + 10;
+    return uint16_t(p[0] << 8 | p[1]);
+}
+
+/********************
+ * Polyglot moves store the target in bits 0-5, the source in bits 6-11
+ * and the promotion piece in bits 12-14 (knight = 1 ... queen = 4).
+ * Castling is encoded as the king capturing its own rook, which is the
+ * same encoding the movegen uses.
+ *******************/
+Move PolyglotBook::toMove(const Board &board, uint16_t move)
+{
+    const Square target = Square(move & 0x3F);
+    const Square source = Square((move >> 6) & 0x3F);
+    const int promotion = (move >> 12) & 0x7;
+
+    Board b = board;
+    Movelist moves;
+    Movegen::legalmoves<Movetype::ALL>(b, moves);
+
+    for (const auto &ext : moves)
+    {
+        if (from(ext.move()) != source || to(ext.move()) != target)
+            continue;
+
+        if (promotion ? promoted(ext.move()) && piece(ext.move()) == PieceType(KNIGHT + promotion - 1)
+                      : !promoted(ext.move()))
+            return ext.move();
+    }
+
+    return NO_MOVE;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <random>
+#include <string>
+
+#include "board.h"
+#include "types.h"
+
+/********************
+ * Polyglot opening book, the file is memory mapped and never copied.
+ * Entries are 16 bytes big endian and sorted by key, so a position
+ * can be found with a binary search.
+ *******************/
+class PolyglotBook
+{
+  public:
+    PolyglotBook() = default;
+    PolyglotBook(const PolyglotBook &) = delete;
+    PolyglotBook &operator=(const PolyglotBook &) = delete;
+    ~PolyglotBook();
+
+    /// @brief map a polyglot book into memory, a previously opened book is closed
+    /// @param path
+    /// @return true if the file could be mapped
+    bool open(const std::string &path);
+
+    /// @brief unmap the book
+    void close();
+
+    bool isOpen() const;
+
+    /// @brief find a book move for the position
+    /// @param board
+    /// @param bestMove pick the move with the highest weight instead of a weighted random one
+    /// @return NO_MOVE if the position is not in the book
+    Move probe(const Board &board, bool bestMove);
+
+    /// @brief the polyglot key of the position, equal to the hashKey
+    /// unless an en passant square is set which no pawn can use
+    /// @param board
+    /// @return
+    static U64 polyglotKey(const Board &board);
+
+  private:
+    const unsigned char *data = nullptr;
+    size_t entryCount = 0;
+    size_t mappedSize = 0;
+
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mapHandle = nullptr;
+#endif
+
+    std::mt19937 generator{std::random_device{}()};
+
+    /// @brief first entry with a key not less than key
+    /// @param key
+    /// @return
+    size_t lowerBound(U64 key) const;
+
+    U64 readKey(size_t index) const;
+    uint16_t readMove(size_t index) const;
+    uint16_t readWeight(size_t index) const;
+
+    /// @brief convert a polyglot move into a legal move of the position
+    /// @param board
+    /// @param move
+    /// @return NO_MOVE if the move is not legal
+    static Move toMove(const Board &board, uint16_t move);
+};
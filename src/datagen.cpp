@@ -112,7 +112,7 @@ void TrainingData::randomPlayout(std::ofstream &file, Board &board, Movelist &mo
 
         int index = randomNum(generator);
 
-        Move move = movelist[index].move;
+        Move move = movelist[index].move();
         board.makeMove<true>(move);
         ply++;
     }
@@ -138,7 +138,7 @@ void TrainingData::randomPlayout(std::ofstream &file, Board &board, Movelist &mo
         search.nodes = 0;
         movelist.size = 0;
 
-        const bool inCheck = board.isSquareAttacked(~board.sideToMove, board.KingSQ(board.sideToMove));
+        const bool inCheck = board.inCheck();
 
         Movegen::legalmoves<Movetype::ALL>(board, movelist);
 
@@ -205,7 +205,7 @@ void TrainingData::randomPlayout(std::ofstream &file, Board &board, Movelist &mo
 
         fens.emplace_back(fn);
 
-        if (useTB && board.halfMoveClock >= 40 && popcount(board.All()) <= 6)
+        if (useTB && board.halfMoveClock >= 40 && board.count() <= 6)
             break;
 
         ply++;
@@ -216,16 +216,16 @@ void TrainingData::randomPlayout(std::ofstream &file, Board &board, Movelist &mo
     U64 white = board.Us<White>();
     U64 black = board.Us<Black>();
     // Set correct winningSide for if (useTB && board.halfMoveClock >= 40 && popcount(board.All()) <= 6)
-    if (useTB && popcount(white | black) <= 6)
+    if (useTB && board.count() <= 6)
     {
         Square ep = board.enPassantSquare <= 63 ? board.enPassantSquare : Square(0);
 
-        unsigned TBresult = tb_probe_wdl(white, black, board.pieces<WhiteKing>() | board.pieces<BlackKing>(),
-                                         board.pieces<WhiteQueen>() | board.pieces<BlackQueen>(),
-                                         board.pieces<WhiteRook>() | board.pieces<BlackRook>(),
-                                         board.pieces<WhiteBishop>() | board.pieces<BlackBishop>(),
-                                         board.pieces<WhiteKnight>() | board.pieces<BlackKnight>(),
-                                         board.pieces<WhitePawn>() | board.pieces<BlackPawn>(), 0, 0, ep,
+        unsigned TBresult = tb_probe_wdl(white, black, board.pieces(KING),
+                                         board.pieces(QUEEN),
+                                         board.pieces(ROOK),
+                                         board.pieces(BISHOP),
+                                         board.pieces(KNIGHT),
+                                         board.pieces(PAWN), 0, 0, ep,
                                          board.sideToMove == White); //  * - turn: true=white, false=black
 
         if (TBresult == TB_LOSS)
@@ -1,14 +1,37 @@
 #include <algorithm> // clamp
 
+#include "bitbase.h"
 #include "evaluation.h"
 #include "nnue.h"
 
 namespace Eval
 {
+
+/********************
+ * KPK positions are decided by the bitbase, drawn positions are exact.
+ * Won positions keep the nnue score but never drop below a floor that
+ * grows with the advancement of the pawn, so the search pushes the pawn.
+ *******************/
+static int32_t evaluateKPK(const Board &board, int32_t v)
+{
+    if (!Bitbase::probe(board))
+        return 0;
+
+    const Color strong = board.pieces<WhitePawn>() ? White : Black;
+    const Square psq = lsb(board.pieces(PAWN, strong));
+    const int rank = strong == White ? square_rank(psq) : RANK_8 - square_rank(psq);
+
+    const int strongScore = std::max(strong == board.sideToMove ? v : -v, 200 + 20 * rank);
+    return strong == board.sideToMove ? strongScore : -strongScore;
+}
+
 Score evaluation(const Board &board)
 {
     int32_t v = NNUE::output(board.getAccumulator(), board.sideToMove);
 
+    if (Bitbase::isKPK(board))
+        v = evaluateKPK(board, v);
+
     v = static_cast<double>(v) * (1.0 - (board.halfMoveClock / 1000.0));
     Score score = std::clamp(static_cast<int>(v), (int32_t)(VALUE_MATED_IN_PLY + 1), (int32_t)(VALUE_MATE_IN_PLY - 1));
     return score;
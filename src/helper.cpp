@@ -148,36 +148,6 @@ void prefetch(const void *addr)
 #endif
 }
 
-void mean_of(int v)
-{
-    means[0]++;
-    means[1] += v;
-}
-
-void max_of(int v)
-{
-    max[0]++;
-    if (v > max[1])
-        max[1] = v;
-}
-
-void min_of(int v)
-{
-    min[0]++;
-    if (v < min[1])
-        min[1] = v;
-}
-
-void print_mean()
-{
-    if (means[0])
-        std::cout << "Total " << means[0] << " Mean " << (double)means[1] / means[0] << std::endl;
-    if (min[0])
-        std::cout << "Total " << min[0] << " Min " << min[1] << std::endl;
-    if (max[0])
-        std::cout << "Total " << max[0] << " Max " << max[1] << std::endl;
-}
-
 std::string outputScore(int score)
 {
     if (std::abs(score) <= 4)
@@ -192,13 +162,18 @@ std::string outputScore(int score)
 }
 
 // clang-format off
-void uciOutput(int score, int depth, uint8_t seldepth, U64 nodes, U64 tbHits, int time, std::string pv, int hashfull)
+void uciOutput(int score, int depth, uint8_t seldepth, U64 nodes, U64 tbHits, int time, std::string pv, int hashfull,
+               int multipv)
 {
     std::stringstream ss;
 
     ss  << "info depth " << signed(depth) 
-        << " seldepth "  << signed(seldepth) 
-        << " score "     << outputScore(score)
+        << " seldepth "  << signed(seldepth);
+
+    if (multipv)
+        ss << " multipv " << multipv;
+
+    ss  << " score "     << outputScore(score)
         << " tbhits "    << tbHits 
         << " nodes "     << nodes 
         << " nps "       << signed((nodes / (time + 1)) * 1000)
@@ -94,16 +94,6 @@ inline constexpr PieceType type_of_piece(const Piece piece)
 /// @param addr
 void prefetch(const void *addr);
 
-[[maybe_unused]] static std::atomic<int64_t> means[2];
-[[maybe_unused]] static std::atomic<int64_t> min[2];
-[[maybe_unused]] static std::atomic<int64_t> max[2];
-
-[[maybe_unused]] void mean_of(int v);
-[[maybe_unused]] void min_of(int v);
-[[maybe_unused]] void max_of(int v);
-
-void print_mean();
-
 /// @brief adjust the outputted score
 /// @param score
 /// @return a new score used for uci output
@@ -117,7 +107,10 @@ std::string outputScore(int score);
 /// @param tbHits
 /// @param time
 /// @param pv
-void uciOutput(int score, int depth, uint8_t seldepth, U64 nodes, U64 tbHits, int time, std::string pv, int hashfull);
+/// @param hashfull
+/// @param multipv index of the pv line, only printed if not 0
+void uciOutput(int score, int depth, uint8_t seldepth, U64 nodes, U64 tbHits, int time, std::string pv, int hashfull,
+               int multipv = 0);
 
 /// @brief makes a Piece from only the piece type and color
 /// @param type
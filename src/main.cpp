@@ -1,5 +1,6 @@
 #include <atomic>
 
+#include "bitbase.h"
 #include "thread.h"
 #include "uci.h"
 
@@ -21,6 +22,9 @@ int main(int argc, char **argv)
     // with.
     NNUE::init("");
 
+    // Generate the KPK bitbase
+    Bitbase::init();
+
     UCI communication = UCI();
     communication.uciLoop(argc, argv);
 }
\ No newline at end of file
@@ -10,4 +10,12 @@ bool hasLegalMoves(Board &board)
     else
         return hasLegalMoves<Black>(board);
 }
+
+int countLegal(Board &board)
+{
+    if (board.sideToMove == White)
+        return countLegal<White>(board);
+    else
+        return countLegal<Black>(board);
+}
 } // namespace Movegen
@@ -1,30 +1,71 @@
 #pragma once
 
+#include <cassert>
+#include <cstdint>
 #include <iterator>
 
 #include "board.h"
 #include "helper.h"
 #include "types.h"
 
+#if defined(USE_SIMD_MOVEGEN) && defined(__AVX512F__)
+#include <immintrin.h>
+#define SIMD_MOVEGEN
+#endif
+
+/********************
+ * A move and its ordering score packed into 32 bits.
+ * The move is stored in the lower half and the signed score in the upper half,
+ * scores have to fit into 16 bits (see MoveScores).
+ *******************/
 struct ExtMove
 {
-    int value = 0;
-    Move move = NO_MOVE;
+    ExtMove() = default;
+
+    constexpr ExtMove(Move move, int score = 0) : data(pack(move, score))
+    {
+    }
+
+    constexpr Move move() const
+    {
+        return Move(data & 0xFFFF);
+    }
+
+    constexpr int score() const
+    {
+        return data >> 16;
+    }
+
+    constexpr void setScore(int score)
+    {
+        assert(score >= INT16_MIN && score <= INT16_MAX);
+        data = pack(move(), score);
+    }
+
+  private:
+    int32_t data = 0;
+
+    static constexpr int32_t pack(Move move, int score)
+    {
+        return int32_t(uint32_t(score) << 16 | move);
+    }
 };
 
+static_assert(sizeof(ExtMove) == 4);
+
 inline constexpr bool operator==(const ExtMove &a, const ExtMove &b)
 {
-    return a.move == b.move;
+    return a.move() == b.move();
 }
 
 inline constexpr bool operator>(const ExtMove &a, const ExtMove &b)
 {
-    return a.value > b.value;
+    return a.score() > b.score();
 }
 
 inline constexpr bool operator<(const ExtMove &a, const ExtMove &b)
 {
-    return a.value < b.value;
+    return a.score() < b.score();
 }
 
 struct Movelist
@@ -36,9 +77,7 @@ struct Movelist
 
     void Add(Move move)
     {
-        list[size].move = move;
-        list[size].value = 0;
-        size++;
+        list[size++] = ExtMove(move);
     }
 
     inline constexpr ExtMove &operator[](int i)
@@ -50,7 +89,7 @@ struct Movelist
     {
         for (int i = 0; i < size; i++)
         {
-            if (list[i].move == m)
+            if (list[i].move() == m)
                 return i;
         }
         return -1;
@@ -92,65 +131,28 @@ template <Color c> U64 pawnRightAttacks(const U64 pawns)
 }
 
 /********************
- * Creates the checkmask.
+ * Creates the checkmask from the checkers the board keeps up to date.
  * A checkmask is the path from the enemy checker to our king.
  * Knight and pawns get themselves added to the checkmask, otherwise the path is added.
  * When there is no check at all all bits are set (DEFAULT_CHECKMASK)
  *******************/
 template <Color c> U64 DoCheckmask(Board &board, Square sq)
 {
-    U64 Occ = board.occAll;
-    U64 checks = 0ULL;
-    U64 pawn_mask = board.pieces<PAWN, ~c>() & PawnAttacks(sq, c);
-    U64 knight_mask = board.pieces<KNIGHT, ~c>() & KnightAttacks(sq);
-    U64 bishop_mask = (board.pieces<BISHOP, ~c>() | board.pieces<QUEEN, ~c>()) & BishopAttacks(sq, Occ);
-    U64 rook_mask = (board.pieces<ROOK, ~c>() | board.pieces<QUEEN, ~c>()) & RookAttacks(sq, Occ);
+    const U64 checkers = board.checkers;
+
+    assert(checkers == board.attackersForSide(~c, sq, board.occAll));
 
     /********************
      * We keep track of the amount of checks, in case there are
      * two checks on the board only the king can move!
      *******************/
-    board.doubleCheck = 0;
+    board.doubleCheck = popcount(checkers);
 
-    if (pawn_mask)
-    {
-        checks |= pawn_mask;
-        board.doubleCheck++;
-    }
-    if (knight_mask)
-    {
-        checks |= knight_mask;
-        board.doubleCheck++;
-    }
-    if (bishop_mask)
-    {
-        int8_t index = lsb(bishop_mask);
+    if (board.doubleCheck != 1)
+        return checkers;
 
-        // Now we add the path!
-        checks |= board.SQUARES_BETWEEN_BB[sq][index] | (1ULL << index);
-        board.doubleCheck++;
-    }
-    if (rook_mask)
-    {
-        /********************
-         * 3nk3/4P3/8/8/8/8/8/2K1R3 w - - 0 1, pawn promotes to queen or rook and
-         * suddenly the same piecetype gives check two times
-         * in that case we have a double check and can return early
-         * because king moves dont require the checkmask.
-         *******************/
-        if (popcount(rook_mask) > 1)
-        {
-            board.doubleCheck = 2;
-            return checks;
-        }
-
-        int8_t index = lsb(rook_mask);
-
-        // Now we add the path!
-        checks |= board.SQUARES_BETWEEN_BB[sq][index] | (1ULL << index);
-        board.doubleCheck++;
-    }
-    return checks;
+    // Now we add the path!
+    return board.SQUARES_BETWEEN_BB[sq][lsb(checkers)] | checkers;
 }
 
 /********************
@@ -234,9 +236,14 @@ template <Color c> void seenSquares(Board &board)
 /********************
  * Creates the pinmask and checkmask
  * setup important variables that we use for move generation.
+ * The masks are kept until the position changes, so the legality checks
+ * of the tt move and the move generation of a node share them.
  *******************/
 template <Color c> void init(Board &board, Square sq)
 {
+    if (board.infoValid)
+        return;
+
     board.occUs = board.Us<c>();
     board.occEnemy = board.Us<~c>();
     board.occAll = board.occUs | board.occEnemy;
@@ -247,6 +254,62 @@ template <Color c> void init(Board &board, Square sq)
     U64 newMask = DoCheckmask<c>(board, sq);
     board.checkMask = newMask ? newMask : DEFAULT_CHECKMASK;
     DoPinMask<c>(board, sq);
+
+    board.infoValid = true;
+}
+
+/********************
+ * Serialization of target bitboards into the movelist.
+ * Every target square "to" becomes the move base + to * mult, pieces use
+ * base = from | piece << 12 and mult = 64, pawns use base = their offset
+ * to the origin square and mult = 65 (from = to + offset).
+ * Built with USE_SIMD_MOVEGEN on AVX-512 hardware 16 squares are expanded at
+ * once and compressed into the movelist, otherwise one move per set bit.
+ *******************/
+template <int mult> void serialize(Movelist &movelist, U64 targets, int base)
+{
+#ifdef SIMD_MOVEGEN
+    const __m512i squares = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i step = _mm512_set1_epi32(16 * mult);
+    __m512i moves = _mm512_add_epi32(_mm512_mullo_epi32(squares, _mm512_set1_epi32(mult)), _mm512_set1_epi32(base));
+
+    for (int i = 0; i < 4 && targets; i++, targets >>= 16, moves = _mm512_add_epi32(moves, step))
+    {
+        const __mmask16 mask = targets & 0xFFFF;
+        if (!mask)
+            continue;
+
+        // the score is 0, so the raw move is the complete ExtMove
+        _mm512_mask_compressstoreu_epi32(&movelist.list[movelist.size], mask, moves);
+        movelist.size += popcount(mask);
+    }
+#else
+    while (targets)
+    {
+        const Square to = poplsb(targets);
+        movelist.Add(Move(base + to * mult));
+    }
+#endif
+}
+
+/// @brief add a move from a square to every target
+/// @tparam pt
+/// @param movelist
+/// @param from
+/// @param targets
+template <PieceType pt> void addMoves(Movelist &movelist, Square from, U64 targets)
+{
+    serialize<64>(movelist, targets, make<pt, false>(from, SQ_A1));
+}
+
+/// @brief add a pawn move to every target, the pawn stands on to + offset
+/// @tparam offset
+/// @param movelist
+/// @param targets
+template <int offset> void addPawnMoves(Movelist &movelist, U64 targets)
+{
+    static_assert(PAWN == 0);
+    serialize<65>(movelist, targets, offset);
 }
 
 /// @brief shift a mask in a direction
@@ -278,35 +341,39 @@ template <Direction direction> constexpr U64 shift(const U64 b)
 
 // all legal moves for each piece
 
-/// @brief all legal pawn moves, generated at once
-/// @tparam c
-/// @tparam mt
-/// @param board
-/// @param movelist
-template <Color c, Movetype mt> void LegalPawnMovesAll(Board &board, Movelist &movelist)
+/********************
+ * Target squares of the legal pawn moves,
+ * promotions are still included in the push and capture targets.
+ *******************/
+struct PawnTargets
 {
-    const U64 pawns_mask = board.pieces<PAWN, c>();
+    U64 left;
+    U64 right;
+    U64 singlePush;
+    U64 doublePush;
+};
 
+template <Color c> PawnTargets LegalPawnTargets(const Board &board)
+{
     constexpr Direction UP = c == White ? NORTH : SOUTH;
-    constexpr Direction DOWN = c == Black ? NORTH : SOUTH;
-    constexpr Direction DOWN_LEFT = c == Black ? NORTH_EAST : SOUTH_WEST;
-    constexpr Direction DOWN_RIGHT = c == Black ? NORTH_WEST : SOUTH_EAST;
-    constexpr U64 RANK_BEFORE_PROMO = c == White ? MASK_RANK[RANK_7] : MASK_RANK[RANK_2];
-    constexpr U64 RANK_PROMO = c == White ? MASK_RANK[RANK_8] : MASK_RANK[RANK_1];
     constexpr U64 doublePushRank = c == White ? MASK_RANK[RANK_3] : MASK_RANK[RANK_6];
 
+    const U64 pawns_mask = board.pieces<PAWN, c>();
+
     // These pawns can maybe take Left or Right
     const U64 pawnsLR = pawns_mask & ~board.pinHV;
 
     const U64 unpinnedpawnsLR = pawnsLR & ~board.pinD;
     const U64 pinnedpawnsLR = pawnsLR & board.pinD;
 
-    U64 Lpawns = (pawnLeftAttacks<c>(unpinnedpawnsLR)) | (pawnLeftAttacks<c>(pinnedpawnsLR) & board.pinD);
-    U64 Rpawns = (pawnRightAttacks<c>(unpinnedpawnsLR)) | (pawnRightAttacks<c>(pinnedpawnsLR) & board.pinD);
+    PawnTargets targets;
+
+    targets.left = (pawnLeftAttacks<c>(unpinnedpawnsLR)) | (pawnLeftAttacks<c>(pinnedpawnsLR) & board.pinD);
+    targets.right = (pawnRightAttacks<c>(unpinnedpawnsLR)) | (pawnRightAttacks<c>(pinnedpawnsLR) & board.pinD);
 
     // Prune moves that dont capture a piece and are not on the checkmask.
-    Lpawns &= board.occEnemy & board.checkMask;
-    Rpawns &= board.occEnemy & board.checkMask;
+    targets.left &= board.occEnemy & board.checkMask;
+    targets.right &= board.occEnemy & board.checkMask;
 
     // These pawns can walk Forward
     const U64 pawnsHV = pawns_mask & ~board.pinD;
@@ -319,21 +386,104 @@ template <Color c, Movetype mt> void LegalPawnMovesAll(Board &board, Movelist &m
     const U64 singlePushPinned = shift<UP>(pawnsPinnedHV) & board.pinHV & ~board.occAll;
 
     // Prune moves that are not on the checkmask.
-    U64 singlePush = (singlePushUnpinned | singlePushPinned) & board.checkMask;
+    targets.singlePush = (singlePushUnpinned | singlePushPinned) & board.checkMask;
+
+    targets.doublePush = ((shift<UP>(singlePushUnpinned & doublePushRank) & ~board.occAll) |
+                          (shift<UP>(singlePushPinned & doublePushRank) & ~board.occAll)) &
+                         board.checkMask;
+
+    return targets;
+}
+
+/// @brief pawns that can legally capture en passant
+/// @tparam c
+/// @param board
+/// @return the origin squares of the en passant captures
+template <Color c> U64 LegalEpPawns(const Board &board)
+{
+    constexpr Direction DOWN = c == Black ? NORTH : SOUTH;
+
+    if (board.enPassantSquare == NO_SQ)
+        return 0ULL;
+
+    const Square ep = board.enPassantSquare;
+    const Square epPawn = ep + DOWN;
+
+    U64 epMask = (1ull << epPawn) | (1ull << ep);
+
+    /********************
+     * In case the en passant square and the enemy pawn
+     * that just moved are not on the checkmask
+     * en passant is not available.
+     *******************/
+    if ((board.checkMask & epMask) == 0)
+        return 0ULL;
+
+    const Square kSQ = board.KingSQ(c);
+    const U64 kingMask = (1ull << kSQ) & MASK_RANK[square_rank(epPawn)];
+    const U64 enemyQueenRook = board.pieces<ROOK, ~c>() | board.pieces<QUEEN, ~c>();
+
+    const bool isPossiblePin = kingMask && enemyQueenRook;
+    U64 epBB = PawnAttacks(ep, ~c) & board.pieces<PAWN, c>() & ~board.pinHV;
+    U64 legal = 0ULL;
+
+    /********************
+     * For one en passant square two pawns could potentially take there.
+     *******************/
+    while (epBB)
+    {
+        Square from = poplsb(epBB);
+
+        /********************
+         * If the pawn is pinned but the en passant square is not on the
+         * pin mask then the move is illegal.
+         *******************/
+        if ((1ULL << from) & board.pinD && !(board.pinD & (1ull << ep)))
+            continue;
+
+        const U64 connectingPawns = (1ull << epPawn) | (1ull << from);
+
+        /********************
+         * 7k/4p3/8/2KP3r/8/8/8/8 b - - 0 1
+         * If e7e5 there will be a potential ep square for us on e6.
+         * However we cannot take en passant because that would put our king
+         * in check. For this scenario we check if theres an enemy rook/queen
+         * that would give check if the two pawns were removed.
+         * If thats the case then the move is illegal and we can break immediately.
+         *******************/
+        if (isPossiblePin && (RookAttacks(kSQ, board.occAll & ~connectingPawns) & enemyQueenRook) != 0)
+            break;
+
+        legal |= 1ULL << from;
+    }
+
+    return legal;
+}
+
+/// @brief all legal pawn moves, generated at once
+/// @tparam c
+/// @tparam mt
+/// @param board
+/// @param movelist
+template <Color c, Movetype mt> void LegalPawnMovesAll(Board &board, Movelist &movelist)
+{
+    constexpr Direction DOWN = c == Black ? NORTH : SOUTH;
+    constexpr Direction DOWN_LEFT = c == Black ? NORTH_EAST : SOUTH_WEST;
+    constexpr Direction DOWN_RIGHT = c == Black ? NORTH_WEST : SOUTH_EAST;
+    constexpr U64 RANK_BEFORE_PROMO = c == White ? MASK_RANK[RANK_7] : MASK_RANK[RANK_2];
+    constexpr U64 RANK_PROMO = c == White ? MASK_RANK[RANK_8] : MASK_RANK[RANK_1];
 
-    U64 doublePush = ((shift<UP>(singlePushUnpinned & doublePushRank) & ~board.occAll) |
-                      (shift<UP>(singlePushPinned & doublePushRank) & ~board.occAll)) &
-                     board.checkMask;
+    PawnTargets targets = LegalPawnTargets<c>(board);
 
     /********************
      * Add promotion moves.
      * These are always generated unless we only want quiet moves.
      *******************/
-    if ((mt != Movetype::QUIET) && pawns_mask & RANK_BEFORE_PROMO)
+    if ((mt != Movetype::QUIET) && board.pieces<PAWN, c>() & RANK_BEFORE_PROMO)
     {
-        U64 Promote_Left = Lpawns & RANK_PROMO;
-        U64 Promote_Right = Rpawns & RANK_PROMO;
-        U64 Promote_Move = singlePush & RANK_PROMO;
+        U64 Promote_Left = targets.left & RANK_PROMO;
+        U64 Promote_Right = targets.right & RANK_PROMO;
+        U64 Promote_Move = targets.singlePush & RANK_PROMO;
 
         while (Promote_Move)
         {
@@ -364,104 +514,60 @@ template <Color c, Movetype mt> void LegalPawnMovesAll(Board &board, Movelist &m
     }
 
     // Remove the promotion pawns
-    singlePush &= ~RANK_PROMO;
-    Lpawns &= ~RANK_PROMO;
-    Rpawns &= ~RANK_PROMO;
-
-    /********************
-     * Add single pushs.
-     *******************/
-    while (mt != Movetype::CAPTURE && singlePush)
-    {
-        Square to = poplsb(singlePush);
-        movelist.Add(make<PAWN, false>(to + DOWN, to));
-    }
+    targets.singlePush &= ~RANK_PROMO;
+    targets.left &= ~RANK_PROMO;
+    targets.right &= ~RANK_PROMO;
 
     /********************
-     * Add double pushs.
+     * Add single and double pushs.
      *******************/
-    while (mt != Movetype::CAPTURE && doublePush)
+    if (mt != Movetype::CAPTURE)
     {
-        Square to = poplsb(doublePush);
-        movelist.Add(make<PAWN, false>(to + DOWN + DOWN, to));
+        addPawnMoves<DOWN>(movelist, targets.singlePush);
+        addPawnMoves<DOWN + DOWN>(movelist, targets.doublePush);
     }
 
     /********************
-     * Add right pawn captures.
+     * Add right and left pawn captures.
      *******************/
-    while (mt != Movetype::QUIET && Rpawns)
+    if (mt != Movetype::QUIET)
     {
-        Square to = poplsb(Rpawns);
-        movelist.Add(make<PAWN, false>(to + DOWN_LEFT, to));
-    }
-
-    /********************
-     * Add left pawn captures.
-     *******************/
-    while (mt != Movetype::QUIET && Lpawns)
-    {
-        Square to = poplsb(Lpawns);
-        movelist.Add(make<PAWN, false>(to + DOWN_RIGHT, to));
+        addPawnMoves<DOWN_LEFT>(movelist, targets.right);
+        addPawnMoves<DOWN_RIGHT>(movelist, targets.left);
     }
 
     /********************
      * Add en passant captures.
      *******************/
-    if (mt != Movetype::QUIET && board.enPassantSquare != NO_SQ)
+    if (mt != Movetype::QUIET)
     {
-        const Square ep = board.enPassantSquare;
-        const Square epPawn = ep + DOWN;
-
-        U64 epMask = (1ull << epPawn) | (1ull << ep);
+        U64 epPawns = LegalEpPawns<c>(board);
 
-        /********************
-         * In case the en passant square and the enemy pawn
-         * that just moved are not on the checkmask
-         * en passant is not available.
-         *******************/
-        if ((board.checkMask & epMask) == 0)
-            return;
-
-        const Square kSQ = board.KingSQ(c);
-        const U64 kingMask = (1ull << kSQ) & MASK_RANK[square_rank(epPawn)];
-        const U64 enemyQueenRook = board.pieces<ROOK, ~c>() | board.pieces<QUEEN, ~c>();
-
-        const bool isPossiblePin = kingMask && enemyQueenRook;
-        U64 epBB = PawnAttacks(ep, ~c) & pawnsLR;
-
-        /********************
-         * For one en passant square two pawns could potentially take there.
-         *******************/
-        while (epBB)
+        while (epPawns)
         {
-            Square from = poplsb(epBB);
-            Square to = ep;
-
-            /********************
-             * If the pawn is pinned but the en passant square is not on the
-             * pin mask then the move is illegal.
-             *******************/
-            if ((1ULL << from) & board.pinD && !(board.pinD & (1ull << ep)))
-                continue;
-
-            const U64 connectingPawns = (1ull << epPawn) | (1ull << from);
-
-            /********************
-             * 7k/4p3/8/2KP3r/8/8/8/8 b - - 0 1
-             * If e7e5 there will be a potential ep square for us on e6.
-             * However we cannot take en passant because that would put our king
-             * in check. For this scenario we check if theres an enemy rook/queen
-             * that would give check if the two pawns were removed.
-             * If thats the case then the move is illegal and we can break immediately.
-             *******************/
-            if (isPossiblePin && (RookAttacks(kSQ, board.occAll & ~connectingPawns) & enemyQueenRook) != 0)
-                break;
-
-            movelist.Add(make<PAWN, false>(from, to));
+            Square from = poplsb(epPawns);
+            movelist.Add(make<PAWN, false>(from, board.enPassantSquare));
         }
     }
 }
 
+/// @brief number of legal pawn moves
+/// @tparam c
+/// @param board
+/// @return
+template <Color c> int LegalPawnMovesCount(const Board &board)
+{
+    constexpr U64 RANK_PROMO = c == White ? MASK_RANK[RANK_8] : MASK_RANK[RANK_1];
+
+    const PawnTargets targets = LegalPawnTargets<c>(board);
+    const int promotions = popcount(targets.left & RANK_PROMO) + popcount(targets.right & RANK_PROMO) +
+                           popcount(targets.singlePush & RANK_PROMO);
+
+    // every promotion target is counted once already, add the other three pieces
+    return popcount(targets.left) + popcount(targets.right) + popcount(targets.singlePush) +
+           popcount(targets.doublePush) + 3 * promotions + popcount(LegalEpPawns<c>(board));
+}
+
 inline U64 LegalKnightMoves(Square sq, U64 movableSquare)
 {
     return KnightAttacks(sq) & movableSquare;
@@ -621,6 +727,26 @@ template <Color c, Movetype mt> U64 LegalKingMovesCastling960(const Board &board
     return moves;
 }
 
+/// @brief king moves including castling, if it is allowed
+/// @tparam c
+/// @tparam mt
+/// @param board
+/// @param sq
+/// @return
+template <Color c, Movetype mt> U64 LegalKingTargets(const Board &board, Square sq)
+{
+    if (board.chess960)
+    {
+        if (mt == Movetype::CAPTURE || board.checkMask != DEFAULT_CHECKMASK)
+            return LegalKingMoves<mt>(board, sq);
+        return LegalKingMovesCastling960<c, mt>(board, sq);
+    }
+
+    if (mt == Movetype::CAPTURE || !board.castlingRights || board.checkMask != DEFAULT_CHECKMASK)
+        return LegalKingMoves<mt>(board, sq);
+    return LegalKingMovesCastling<c, mt>(board, sq);
+}
+
 // all legal moves for a position
 template <Color c, Movetype mt> void legalmoves(Board &board, Movelist &movelist)
 {
@@ -650,28 +776,8 @@ template <Color c, Movetype mt> void legalmoves(Board &board, Movelist &movelist
         movableSquare &= ~board.occAll;
 
     Square from = board.KingSQ(c);
-    U64 moves;
-
-    if (board.chess960)
-    {
-        if (mt == Movetype::CAPTURE || board.checkMask != DEFAULT_CHECKMASK)
-            moves = LegalKingMoves<mt>(board, from);
-        else
-            moves = LegalKingMovesCastling960<c, mt>(board, from);
-    }
-    else
-    {
-        if (mt == Movetype::CAPTURE || !board.castlingRights || board.checkMask != DEFAULT_CHECKMASK)
-            moves = LegalKingMoves<mt>(board, from);
-        else
-            moves = LegalKingMovesCastling<c, mt>(board, from);
-    }
 
-    while (moves)
-    {
-        Square to = poplsb(moves);
-        movelist.Add(make<KING, false>(from, to));
-    }
+    addMoves<KING>(movelist, from, LegalKingTargets<c, mt>(board, from));
 
     /********************
      * Early return for double check as described earlier
@@ -707,45 +813,25 @@ template <Color c, Movetype mt> void legalmoves(Board &board, Movelist &movelist
     while (knights_mask)
     {
         Square from = poplsb(knights_mask);
-        U64 moves = LegalKnightMoves(from, movableSquare);
-        while (moves)
-        {
-            Square to = poplsb(moves);
-            movelist.Add(make<KNIGHT, false>(from, to));
-        }
+        addMoves<KNIGHT>(movelist, from, LegalKnightMoves(from, movableSquare));
     }
 
     while (bishops_mask)
     {
         Square from = poplsb(bishops_mask);
-        U64 moves = LegalBishopMoves(board, from, movableSquare);
-        while (moves)
-        {
-            Square to = poplsb(moves);
-            movelist.Add(make<BISHOP, false>(from, to));
-        }
+        addMoves<BISHOP>(movelist, from, LegalBishopMoves(board, from, movableSquare));
     }
 
     while (rooks_mask)
     {
         Square from = poplsb(rooks_mask);
-        U64 moves = LegalRookMoves(board, from, movableSquare);
-        while (moves)
-        {
-            Square to = poplsb(moves);
-            movelist.Add(make<ROOK, false>(from, to));
-        }
+        addMoves<ROOK>(movelist, from, LegalRookMoves(board, from, movableSquare));
     }
 
     while (queens_mask)
     {
         Square from = poplsb(queens_mask);
-        U64 moves = LegalQueenMoves(board, from, movableSquare);
-        while (moves)
-        {
-            Square to = poplsb(moves);
-            movelist.Add(make<QUEEN, false>(from, to));
-        }
+        addMoves<QUEEN>(movelist, from, LegalQueenMoves(board, from, movableSquare));
     }
 }
 
@@ -764,33 +850,13 @@ template <Movetype mt> void legalmoves(Board &board, Movelist &movelist)
 // basically a mirror of legalmoves but with early returns
 template <Color c> bool hasLegalMoves(Board &board)
 {
-    Movelist movelist;
-
     init<c>(board, board.KingSQ(c));
 
     assert(board.doubleCheck <= 2);
 
     U64 movableSquare = board.checkMask & board.enemyEmptyBB;
 
-    Square from = board.KingSQ(c);
-    U64 moves;
-
-    if (board.chess960)
-    {
-        if (board.checkMask != DEFAULT_CHECKMASK)
-            moves = LegalKingMoves<Movetype::ALL>(board, from);
-        else
-            moves = LegalKingMovesCastling960<c, Movetype::ALL>(board, from);
-    }
-    else
-    {
-        if (!board.castlingRights || board.checkMask != DEFAULT_CHECKMASK)
-            moves = LegalKingMoves<Movetype::ALL>(board, from);
-        else
-            moves = LegalKingMovesCastling<c, Movetype::ALL>(board, from);
-    }
-
-    if (moves)
+    if (LegalKingTargets<c, Movetype::ALL>(board, board.KingSQ(c)))
         return true;
 
     if (board.doubleCheck == 2)
@@ -801,7 +867,8 @@ template <Color c> bool hasLegalMoves(Board &board)
     U64 rooks_mask = board.pieces<ROOK, c>() & ~board.pinD;
     U64 queens_mask = board.pieces<QUEEN, c>() & ~(board.pinD & board.pinHV);
 
-    LegalPawnMovesAll<c, Movetype::ALL>(board, movelist);
+    if (LegalPawnMovesCount<c>(board))
+        return true;
 
     while (knights_mask)
     {
@@ -840,6 +907,47 @@ template <Color c> bool hasLegalMoves(Board &board)
 
 bool hasLegalMoves(Board &board);
 
+/********************
+ * Number of legal moves, a mirror of legalmoves
+ * that popcounts the targets instead of writing the moves.
+ *******************/
+template <Color c> int countLegal(Board &board)
+{
+    init<c>(board, board.KingSQ(c));
+
+    assert(board.doubleCheck <= 2);
+
+    int count = popcount(LegalKingTargets<c, Movetype::ALL>(board, board.KingSQ(c)));
+
+    if (board.doubleCheck == 2)
+        return count;
+
+    const U64 movableSquare = board.checkMask & board.enemyEmptyBB;
+
+    U64 knights_mask = board.pieces<KNIGHT, c>() & ~(board.pinD | board.pinHV);
+    U64 bishops_mask = board.pieces<BISHOP, c>() & ~board.pinHV;
+    U64 rooks_mask = board.pieces<ROOK, c>() & ~board.pinD;
+    U64 queens_mask = board.pieces<QUEEN, c>() & ~(board.pinD & board.pinHV);
+
+    count += LegalPawnMovesCount<c>(board);
+
+    while (knights_mask)
+        count += popcount(LegalKnightMoves(poplsb(knights_mask), movableSquare));
+
+    while (bishops_mask)
+        count += popcount(LegalBishopMoves(board, poplsb(bishops_mask), movableSquare));
+
+    while (rooks_mask)
+        count += popcount(LegalRookMoves(board, poplsb(rooks_mask), movableSquare));
+
+    while (queens_mask)
+        count += popcount(LegalQueenMoves(board, poplsb(queens_mask), movableSquare));
+
+    return count;
+}
+
+int countLegal(Board &board);
+
 // pseudo legal moves number estimation
 template <Color c> int pseudoLegalMovesNumber(const Board &board)
 {
@@ -14,8 +14,7 @@ template <SearchType st> class MovePick
 {
   public:
     MovePick(Search &sh, Stack *s, Movelist &moves, const Move move);
-    MovePick(Search &sh, Stack *s, Movelist &moves, const Movelist &searchmoves, bool rootNode, const Move move,
-             Staging entry);
+    MovePick(Search &sh, Stack *s, Movelist &moves, bool rootNode, const Move move, Staging entry);
 
     Move nextMove();
 
@@ -30,6 +29,9 @@ template <SearchType st> class MovePick
     int played = 0;
     bool playedTT = false;
 
+    // root moves keep the order of the root move list
+    bool rootNode = false;
+
     template <bool score> Move orderNext();
 
     int mvvlva(const Move move) const;
@@ -46,26 +48,25 @@ MovePick<st>::MovePick(Search &sh, Stack *s, Movelist &moves, const Move move)
 }
 
 template <SearchType st>
-MovePick<st>::MovePick(Search &sh, Stack *s, Movelist &moves, const Movelist &searchmoves, bool rootNode,
-                       const Move move, Staging entry)
-    : search(sh), ss(s), movelist(moves), ttMove(move)
+MovePick<st>::MovePick(Search &sh, Stack *s, Movelist &moves, bool rootNode, const Move move, Staging entry)
+    : search(sh), ss(s), movelist(moves), ttMove(move), rootNode(rootNode)
 {
     movelist.size = 0;
     played = 0;
     stage = entry;
 
-    if (rootNode && searchmoves.size)
+    // the lines of earlier multipv iterations are not searched again
+    if (rootNode)
     {
-        movelist = searchmoves;
-        stage = PICK_NEXT;
+        const auto &rootMoves = search.rootMoves;
 
-        for (auto &ext : movelist)
-        {
-            if (ext.move == ttMove)
-                ext.value = 10'000'000;
-            else
-                ext.value = scoreMove(ext.move);
-        }
+        for (std::size_t i = search.pvIdx; i < rootMoves.size(); i++)
+            movelist.Add(rootMoves[i].move);
+
+        for (int i = 0; i < movelist.size; i++)
+            movelist[i].setScore(movelist.size - i);
+
+        stage = PICK_NEXT;
     }
 }
 
@@ -73,12 +74,12 @@ template <SearchType st> template <bool score> Move MovePick<st>::orderNext()
 {
     int index = played;
     if constexpr (score)
-        movelist[index].value = scoreMove(movelist[index].move);
+        movelist[index].setScore(scoreMove(movelist[index].move()));
 
     for (int i = 1 + played; i < movelist.size; i++)
     {
         if constexpr (score)
-            movelist[i].value = scoreMove(movelist[i].move);
+            movelist[i].setScore(scoreMove(movelist[i].move()));
 
         if (movelist[i] > movelist[index])
             index = i;
@@ -86,7 +87,7 @@ template <SearchType st> template <bool score> Move MovePick<st>::orderNext()
 
     std::swap(movelist[index], movelist[played]);
 
-    return movelist[played++].move;
+    return movelist[played++].move();
 }
 
 template <SearchType st> Move MovePick<st>::nextMove()
@@ -116,7 +117,7 @@ template <SearchType st> Move MovePick<st>::nextMove()
         while (played < movelist.size)
         {
             Move move = NO_MOVE;
-            if (played == 0)
+            if (played == 0 && !rootNode)
                 move = orderNext<true>();
             else
                 move = orderNext<false>();
@@ -1,5 +1,8 @@
 
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "nnue.h"
 
@@ -17,6 +20,27 @@ int32_t outputBias[OUTPUT_BIAS];
 namespace NNUE
 {
 
+// [node], node local copies of inputWeights
+static std::vector<std::unique_ptr<int16_t[]>> replicas;
+static std::mutex replicaMutex;
+
+const int16_t *localInputWeights(int node)
+{
+    std::lock_guard<std::mutex> lock(replicaMutex);
+
+    if (int(replicas.size()) <= node)
+        replicas.resize(node + 1);
+
+    if (!replicas[node])
+    {
+        // the copy is written by the calling thread, so the pages end up on its node
+        replicas[node] = std::make_unique<int16_t[]>(FEATURE_SIZE * N_HIDDEN_SIZE);
+        std::memcpy(replicas[node].get(), inputWeights, FEATURE_SIZE * N_HIDDEN_SIZE * sizeof(int16_t));
+    }
+
+    return replicas[node].get();
+}
+
 int idx(Color side, Square sq, Piece p)
 {
     if (side == White)
@@ -33,7 +57,7 @@ int idx(Color side, Square sq, Piece p)
     }
 }
 
-void activate(NNUE::accumulator &accumulator, Square sq, Piece p)
+void activate(NNUE::accumulator &accumulator, Square sq, Piece p, const int16_t *weights)
 {
     for (auto side : {White, Black})
     {
@@ -43,13 +67,13 @@ void activate(NNUE::accumulator &accumulator, Square sq, Piece p)
             const int offset = chunks * 256;
             for (int i = offset; i < 256 + offset; i++)
             {
-                accumulator[side][i] += inputWeights[input * N_HIDDEN_SIZE + i];
+                accumulator[side][i] += weights[input * N_HIDDEN_SIZE + i];
             }
         }
     }
 }
 
-void deactivate(NNUE::accumulator &accumulator, Square sq, Piece p)
+void deactivate(NNUE::accumulator &accumulator, Square sq, Piece p, const int16_t *weights)
 {
     for (auto side : {White, Black})
     {
@@ -59,13 +83,13 @@ void deactivate(NNUE::accumulator &accumulator, Square sq, Piece p)
             const int offset = chunks * 256;
             for (int i = offset; i < 256 + offset; i++)
             {
-                accumulator[side][i] -= inputWeights[input * N_HIDDEN_SIZE + i];
+                accumulator[side][i] -= weights[input * N_HIDDEN_SIZE + i];
             }
         }
     }
 }
 
-void move(NNUE::accumulator &accumulator, Square from_sq, Square to_sq, Piece p)
+void move(NNUE::accumulator &accumulator, Square from_sq, Square to_sq, Piece p, const int16_t *weights)
 {
     for (auto side : {White, Black})
     {
@@ -78,7 +102,7 @@ void move(NNUE::accumulator &accumulator, Square from_sq, Square to_sq, Piece p)
             for (int i = offset; i < 256 + offset; i++)
             {
                 accumulator[side][i] +=
-                    -inputWeights[inputClear * N_HIDDEN_SIZE + i] + inputWeights[inputAdd * N_HIDDEN_SIZE + i];
+                    -weights[inputClear * N_HIDDEN_SIZE + i] + weights[inputAdd * N_HIDDEN_SIZE + i];
             }
         }
     }
@@ -117,6 +141,11 @@ int32_t output(const NNUE::accumulator &accumulator, Color side)
 
 void init(const char *filename)
 {
+    {
+        std::lock_guard<std::mutex> lock(replicaMutex);
+        replicas.clear();
+    }
+
     FILE *f = fopen(filename, "rb");
 
     // obtain file size
@@ -27,14 +27,19 @@ int16_t relu(int16_t x);
 // load the weights and bias
 void init(const char *filename);
 
+// copy of inputWeights for a numa node, created and first touched by the calling thread
+// which has to be bound to that node. The copies are dropped when a new network is loaded.
+const int16_t *localInputWeights(int node);
+
 // activate a certain input and update the accumulator
-void activate(NNUE::accumulator &accumulator, Square sq, Piece p);
+void activate(NNUE::accumulator &accumulator, Square sq, Piece p, const int16_t *weights = inputWeights);
 
 // deactivate a certain input and update the accumulator
-void deactivate(NNUE::accumulator &accumulator, Square sq, Piece p);
+void deactivate(NNUE::accumulator &accumulator, Square sq, Piece p, const int16_t *weights = inputWeights);
 
 // activate and deactivate, mirrors the logic of a move
-void move(NNUE::accumulator &accumulator, Square from_sq, Square to_sq, Piece p);
+void move(NNUE::accumulator &accumulator, Square from_sq, Square to_sq, Piece p,
+          const int16_t *weights = inputWeights);
 
 // return the nnue evaluation
 int32_t output(const NNUE::accumulator &accumulator, Color side);
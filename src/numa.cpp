@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "numa.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace Numa
+{
+
+namespace
+{
+
+/// @brief parse a kernel cpu list like "0-3,8-11"
+std::vector<int> parseCpuList(const std::string &list)
+{
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+
+    while (std::getline(ss, range, ','))
+    {
+        if (range.empty() || !std::isdigit(static_cast<unsigned char>(range[0])))
+            continue;
+
+        const std::size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+        for (int cpu = first; cpu <= last; cpu++)
+            cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
+
+std::vector<std::vector<int>> readTopology()
+{
+    std::vector<std::vector<int>> topology;
+
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    auto isAllowed = [&](int cpu) { return !haveMask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)); };
+
+    // node ids can have gaps, so take them from the list of online nodes
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string onlineList;
+
+    if (online && std::getline(online, onlineList))
+    {
+        for (int node : parseCpuList(onlineList))
+        {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string list;
+
+            if (!file || !std::getline(file, list))
+                continue;
+
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(list))
+                if (isAllowed(cpu))
+                    cpus.push_back(cpu);
+
+            // skip nodes with memory only or without allowed cpus
+            if (!cpus.empty())
+                topology.push_back(cpus);
+        }
+    }
+
+    if (topology.empty() && haveMask)
+    {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (CPU_ISSET(cpu, &allowed))
+                cpus.push_back(cpu);
+
+        topology.push_back(cpus);
+    }
+#endif
+
+    if (topology.empty())
+    {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < int(std::max(1u, std::thread::hardware_concurrency())); cpu++)
+            cpus.push_back(cpu);
+
+        topology.push_back(cpus);
+    }
+
+    return topology;
+}
+
+/// @brief node and cpu of a thread, the cpus are enumerated node by node
+std::pair<int, int> placement(int threadId)
+{
+    const auto &topology = nodes();
+
+    int cpuCount = 0;
+    for (const auto &cpus : topology)
+        cpuCount += cpus.size();
+
+    int index = threadId % cpuCount;
+
+    for (int node = 0; node < int(topology.size()); node++)
+    {
+        if (index < int(topology[node].size()))
+            return {node, topology[node][index]};
+
+        index -= topology[node].size();
+    }
+
+    return {0, topology[0][0]};
+}
+
+std::string cpuListString(const std::vector<int> &cpus)
+{
+    std::stringstream ss;
+
+    for (std::size_t i = 0; i < cpus.size(); i++)
+    {
+        std::size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1)
+            j++;
+
+        ss << (i ? "," : "") << cpus[i];
+        if (j != i)
+            ss << "-" << cpus[j];
+
+        i = j;
+    }
+
+    return ss.str();
+}
+
+} // namespace
+
+Binding parseBinding(const std::string &value)
+{
+    if (value == "numa")
+        return Binding::NUMA;
+    if (value == "cpu")
+        return Binding::CPU;
+    return Binding::NONE;
+}
+
+const std::vector<std::vector<int>> &nodes()
+{
+    static const std::vector<std::vector<int>> topology = readTopology();
+    return topology;
+}
+
+int nodeOf(int threadId, Binding binding)
+{
+    if (binding == Binding::NONE)
+        return 0;
+
+    return placement(threadId).first;
+}
+
+bool bindThread(int threadId, Binding binding)
+{
+    if (binding == Binding::NONE)
+        return true;
+
+#ifdef __linux__
+    const auto [node, cpu] = placement(threadId);
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+
+    if (binding == Binding::CPU)
+        CPU_SET(cpu, &mask);
+    else
+        for (int c : nodes()[node])
+            CPU_SET(c, &mask);
+
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+    return false;
+#endif
+}
+
+void printPlacement(int threadCount, Binding binding)
+{
+    const auto &topology = nodes();
+
+    for (int node = 0; node < int(topology.size()); node++)
+        std::cout << "info string numa node " << node << " cpus " << cpuListString(topology[node]) << std::endl;
+
+    if (binding == Binding::NONE)
+        return;
+
+#ifndef __linux__
+    std::cout << "info string thread binding is only supported on Linux" << std::endl;
+    return;
+#endif
+
+    for (int id = 0; id < threadCount; id++)
+    {
+        const auto [node, cpu] = placement(id);
+
+        std::cout << "info string thread " << id << " bound to ";
+        if (binding == Binding::CPU)
+            std::cout << "cpu " << cpu << " (node " << node << ")" << std::endl;
+        else
+            std::cout << "node " << node << std::endl;
+    }
+}
+
+} // namespace Numa
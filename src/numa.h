@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Numa
+{
+
+enum class Binding
+{
+    NONE,
+    NUMA,
+    CPU
+};
+
+/// @brief parse the value of the ThreadBinding option
+/// @param value "none", "numa" or "cpu"
+/// @return
+Binding parseBinding(const std::string &value);
+
+/// @brief cpus of every numa node, read once from /sys/devices/system/node.
+/// Only cpus this process is allowed to run on are included. Without numa
+/// information all cpus form a single node.
+/// @return
+const std::vector<std::vector<int>> &nodes();
+
+/// @brief the node a search thread is placed on, threads fill the cpus of
+/// the first node before moving on to the next one
+/// @param threadId
+/// @return 0 if no binding is used
+int nodeOf(int threadId, Binding binding);
+
+/// @brief bind the calling thread to its numa node or its cpu
+/// @param threadId
+/// @param binding
+/// @return false if the affinity could not be set
+bool bindThread(int threadId, Binding binding);
+
+/// @brief print the topology and where the threads will be placed as info strings
+/// @param threadCount
+/// @param binding
+void printPlacement(int threadCount, Binding binding);
+
+} // namespace Numa
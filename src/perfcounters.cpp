@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "perfcounters.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// clang-format off
+static constexpr std::array<const char *, PerfCounters::EVENT_NB> eventNames = {
+    "cycles",
+    "instructions",
+    "L1d misses",
+    "LLC misses",
+    "branch misses",
+    "dTLB misses"
+};
+// clang-format on
+
+#ifdef __linux__
+
+static constexpr uint64_t cacheEvent(uint64_t cache, uint64_t op, uint64_t result)
+{
+    return cache | (op << 8) | (result << 16);
+}
+
+// clang-format off
+static constexpr std::array<std::pair<uint32_t, uint64_t>, PerfCounters::EVENT_NB> eventConfigs = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D,  PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_LL,   PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+}};
+// clang-format on
+
+PerfCounters::~PerfCounters()
+{
+    for (int &fd : fds)
+    {
+        if (fd != -1)
+            close(fd);
+        fd = -1;
+    }
+}
+
+bool PerfCounters::open()
+{
+    bool opened = false;
+
+    for (int i = 0; i < EVENT_NB; i++)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+
+        attr.size = sizeof(attr);
+        attr.type = eventConfigs[i].first;
+        attr.config = eventConfigs[i].second;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // this thread and all threads created later, on any cpu,
+        // their events are summed up into a single value
+        fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+
+        if (fds[i] == -1)
+            error = std::strerror(errno);
+        else
+            opened = true;
+    }
+
+    return opened;
+}
+
+void PerfCounters::start()
+{
+    for (int fd : fds)
+    {
+        if (fd == -1)
+            continue;
+
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void PerfCounters::stop()
+{
+    for (int i = 0; i < EVENT_NB; i++)
+    {
+        if (fds[i] == -1)
+            continue;
+
+        ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        read(Event(i));
+    }
+}
+
+void PerfCounters::read(Event event)
+{
+    // value, time enabled, time running
+    uint64_t data[3] = {};
+
+    valid[event] = ::read(fds[event], data, sizeof(data)) == sizeof(data) && data[2] != 0;
+
+    if (valid[event])
+        values[event] = data[2] < data[1] ? uint64_t(double(data[0]) * data[1] / data[2]) : data[0];
+}
+
+#else
+
+PerfCounters::~PerfCounters()
+{
+}
+
+bool PerfCounters::open()
+{
+    error = "only supported on Linux";
+    return false;
+}
+
+void PerfCounters::start()
+{
+}
+
+void PerfCounters::stop()
+{
+}
+
+void PerfCounters::read(Event)
+{
+}
+
+#endif
+
+void PerfCounters::print(uint64_t nodes) const
+{
+    std::cout << "\nPerformance counters" << std::endl;
+
+    if (!error.empty() && std::none_of(valid.begin(), valid.end(), [](bool v) { return v; }))
+    {
+        std::cout << "not available: " << error << std::endl;
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (int i = 0; i < EVENT_NB; i++)
+    {
+        std::cout << std::left << std::setw(16) << eventNames[i] << std::right;
+
+        if (!valid[i])
+        {
+            std::cout << "not supported" << std::endl;
+            continue;
+        }
+
+        std::cout << std::setw(16) << values[i] << std::setw(12) << (nodes ? double(values[i]) / nodes : 0.0)
+                  << " per node" << std::endl;
+    }
+
+    if (valid[CYCLES] && valid[INSTRUCTIONS] && values[CYCLES])
+        std::cout << std::left << std::setw(16) << "IPC" << std::right << std::setw(16)
+                  << double(values[INSTRUCTIONS]) / values[CYCLES] << std::endl;
+
+    std::cout << std::defaultfloat;
+}
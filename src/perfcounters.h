@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/********************
+ * Hardware performance counters for the bench, based on perf_event_open.
+ * Only available on Linux, everywhere else (or when the kernel refuses to
+ * open the counters) the counters are reported as unavailable.
+ * Kernel and hypervisor events are excluded, so a perf_event_paranoid
+ * level of 2 is enough.
+ * The counters are inherited by threads created after open() and report
+ * the sum over all of them, there is no per thread breakdown. The bench
+ * searches in the calling thread, so the sum is the single thread cost.
+ *******************/
+class PerfCounters
+{
+  public:
+    enum Event : int
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        DTLB_MISSES,
+        EVENT_NB
+    };
+
+    PerfCounters() = default;
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    ~PerfCounters();
+
+    /// @brief open all counters for the calling thread and the threads it creates afterwards
+    /// @return true if at least one counter could be opened
+    bool open();
+
+    void start();
+
+    void stop();
+
+    /// @brief print the counter values, both in total and per searched node
+    /// @param nodes
+    void print(uint64_t nodes) const;
+
+  private:
+    std::array<int, EVENT_NB> fds = {-1, -1, -1, -1, -1, -1};
+
+    // values scaled by the time the counter was actually running
+    std::array<uint64_t, EVENT_NB> values = {};
+    std::array<bool, EVENT_NB> valid = {};
+
+    std::string error;
+
+    /// @brief read a counter and scale it if it was multiplexed
+    /// @param event
+    void read(Event event);
+};
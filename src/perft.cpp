@@ -1,21 +1,74 @@
+#include <thread>
 #include <vector>
 
 #include "perft.h"
 
+PerftHash::PerftHash(std::size_t mb) : entries(std::max<std::size_t>(mb * 1024 * 1024 / sizeof(Entry), 1))
+{
+}
+
+bool PerftHash::probe(U64 key, int depth, U64 &nodes) const
+{
+    const Entry &entry = entries[index(key)];
+    const U64 data = entry.data.load(std::memory_order_relaxed);
+
+    if ((entry.check.load(std::memory_order_relaxed) ^ data) != key || int(data & 0xFF) != depth)
+        return false;
+
+    nodes = data >> 8;
+    return true;
+}
+
+void PerftHash::store(U64 key, int depth, U64 nodes)
+{
+    Entry &entry = entries[index(key)];
+    const U64 data = nodes << 8 | U64(depth);
+
+    entry.check.store(key ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+void Perft::setHash(std::size_t mb)
+{
+    hashSize = mb;
+    hash = mb ? std::make_shared<PerftHash>(mb) : nullptr;
+}
+
+U64 Perft::hashKey() const
+{
+    if (!board.chess960)
+        return board.hashKey;
+
+    // the zobrist key only knows the castling rights of the corner rooks,
+    // in frc the files of the castling rooks have to be added (NO_FILE is -1)
+    const U64 rights = (board.castlingRights960White[0] & 0xF) | (board.castlingRights960White[1] & 0xF) << 4 |
+                       (board.castlingRights960Black[0] & 0xF) << 8 | (board.castlingRights960Black[1] & 0xF) << 12;
+
+    return board.hashKey ^ (rights * 0x9E3779B97F4A7C15ULL);
+}
+
 U64 Perft::perftFunction(int depth, int max)
 {
-    movelists[depth].size = 0;
-    Movegen::legalmoves<Movetype::ALL>(board, movelists[depth]);
     if (depth == 0)
         return 1;
     else if (depth == 1 && max != 1)
     {
-        return movelists[depth].size;
+        return Movegen::countLegal(board);
     }
+
+    // the root counts every move on its own for the divide output
+    const bool useHash = hash && depth != max;
+    U64 cached;
+
+    if (useHash && hash->probe(hashKey(), depth, cached))
+        return cached;
+
+    movelists[depth].size = 0;
+    Movegen::legalmoves<Movetype::ALL>(board, movelists[depth]);
     U64 nodesIt = 0;
     for (auto extmove : movelists[depth])
     {
-        Move move = extmove.move;
+        Move move = extmove.move();
         board.makeMove<false>(move);
         nodesIt += perftFunction(depth - 1, depth);
         board.unmakeMove<false>(move);
@@ -26,13 +79,58 @@ U64 Perft::perftFunction(int depth, int max)
             nodesIt = 0;
         }
     }
+
+    if (useHash)
+        hash->store(hashKey(), depth, nodesIt);
+
     return nodesIt;
 }
 
+void Perft::splitRoot(int depth)
+{
+    Movelist rootMoves;
+    Movegen::legalmoves<Movetype::ALL>(board, rootMoves);
+
+    std::vector<U64> counts(rootMoves.size);
+    std::atomic<int> next{0};
+
+    auto worker = [&]() {
+        // every thread owns a board and movelists, only the hash is shared
+        auto perft = std::make_unique<Perft>();
+        perft->board = board;
+        perft->hash = hash;
+
+        for (int i = next++; i < rootMoves.size; i = next++)
+        {
+            const Move move = rootMoves[i].move();
+
+            perft->board.makeMove<false>(move);
+            counts[i] = perft->perftFunction(depth - 1, depth);
+            perft->board.unmakeMove<false>(move);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++)
+        workers.emplace_back(worker);
+
+    for (auto &t : workers)
+        t.join();
+
+    for (int i = 0; i < rootMoves.size; i++)
+    {
+        nodes += counts[i];
+        std::cout << uciMove(rootMoves[i].move(), board.chess960) << " " << counts[i] << std::endl;
+    }
+}
+
 void Perft::perfTest(int depth, int max)
 {
     auto t1 = TimePoint::now();
-    perftFunction(depth, max);
+    if (threads > 1 && depth == max && depth > 1)
+        splitRoot(depth);
+    else
+        perftFunction(depth, max);
     auto t2 = TimePoint::now();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
     std::cout << "\ntime: " << ms << "ms" << std::endl;
@@ -44,6 +142,9 @@ void Perft::testAllPos(int n)
     U64 mnps = 0;
     for (int runs = 0; runs < n; runs++)
     {
+        // a new table for every run, otherwise later runs only measure the hash
+        setHash(hashSize);
+
         auto t1 = TimePoint::now();
         U64 total = 0;
         size_t passed = 0;
@@ -120,4 +221,6 @@ void Perft::testAllPos(int n)
         std::cout << "Correct Positions  : " << passed << "/" << expected.size() + expected960.size() << std::endl;
     }
     std::cout << "Avg Nodes/second   : " << mnps / n << std::endl;
+    std::cout << "Threads            : " << threads << std::endl;
+    std::cout << "Hash (MB)          : " << hashSize << std::endl;
 }
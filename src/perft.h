@@ -1,20 +1,76 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "board.h"
 #include "movegen.h"
 
+/********************
+ * Perft node counts of visited positions, keyed by the hash key and the depth.
+ * The entries are shared by all perft threads without locks, the key is stored
+ * xor'ed with the data, so an entry torn by two concurrent writes fails the check.
+ *******************/
+class PerftHash
+{
+  public:
+    /// @brief allocate the table
+    /// @param mb size in MB
+    explicit PerftHash(std::size_t mb);
+
+    bool probe(U64 key, int depth, U64 &nodes) const;
+
+    void store(U64 key, int depth, U64 nodes);
+
+  private:
+    struct Entry
+    {
+        std::atomic<U64> check{0};
+
+        // nodes << 8 | depth
+        std::atomic<U64> data{0};
+    };
+
+    std::vector<Entry> entries;
+
+    std::size_t index(U64 key) const
+    {
+        return ((uint32_t)key * entries.size()) >> 32;
+    }
+};
+
 class Perft
 {
   public:
     Board board;
     int depth;
-    uint64_t nodes;
+    uint64_t nodes = 0;
     Movelist movelists[MAX_PLY];
 
+    // threads searching the root moves in parallel
+    int threads = 1;
+
+    /// @brief use a perft hash of the given size, 0 disables it
+    /// @param mb
+    void setHash(std::size_t mb);
+
     U64 perftFunction(int depth, int max);
 
     void perfTest(int depth, int max);
 
     /// @brief perfs a test on all test positions
     void testAllPos(int n = 1);
-};
\ No newline at end of file
+
+  private:
+    std::shared_ptr<PerftHash> hash;
+
+    std::size_t hashSize = 0;
+
+    /// @brief count the root moves on multiple threads, prints the same divide as perftFunction
+    void splitRoot(int depth);
+
+    /// @brief hash key of the board for the perft hash
+    /// @return
+    U64 hashKey() const;
+};
@@ -1,6 +1,7 @@
 #include <algorithm> // clamp
 #include <cmath>
 
+#include "bitbase.h"
 #include "evaluation.h"
 #include "movepick.h"
 #include "search.h"
@@ -11,6 +12,24 @@ extern ThreadPool Threads;
 extern TranspositionTable TTable;
 extern std::atomic_bool stopped;
 
+// moves that are currently searched by any thread
+static SearchingTable searchingMoves;
+
+// minimum depth at which moves are marked and deferred
+static constexpr int DEFER_DEPTH = 4;
+
+// moves deferred per node, further busy moves are searched right away
+static constexpr int MAX_DEFERRED = 32;
+
+/********************
+ * Depth schedule of the helper threads, helper i skips the
+ * iterations where ((depth + SkipPhase[i]) / SkipSize[i]) is odd.
+ * The threads then work on different depths at the same time.
+ *******************/
+static constexpr int SKIP_THREADS = 20;
+static constexpr int SkipSize[SKIP_THREADS] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+static constexpr int SkipPhase[SKIP_THREADS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
 // Initialize reduction table
 int reductions[MAX_PLY][MAX_MOVES];
 
@@ -30,6 +49,20 @@ int bonus(int depth)
     return std::min(2000, depth * 155);
 }
 
+/// @brief the new pv is the move followed by the pv of the child
+/// @param pv
+/// @param move
+/// @param childPv
+void updatePv(Move *pv, Move move, const Move *childPv)
+{
+    *pv++ = move;
+
+    while (*childPv != NO_MOVE)
+        *pv++ = *childPv++;
+
+    *pv = NO_MOVE;
+}
+
 template <Movetype type> void Search::updateHistoryBonus(Move move, int bonus)
 {
     int hhBonus = bonus - getHistory<type>(move, *this) * std::abs(bonus) / 16384;
@@ -83,7 +116,7 @@ template <Node node> Score Search::qsearch(Score alpha, Score beta, Stack *ss)
      *******************/
     constexpr bool PvNode = node == PV;
     const Color color = board.sideToMove;
-    const bool inCheck = board.isSquareAttacked(~color, board.KingSQ(color));
+    const bool inCheck = board.inCheck();
 
     Move bestMove = NO_MOVE;
 
@@ -103,7 +136,12 @@ template <Node node> Score Search::qsearch(Score alpha, Score beta, Stack *ss)
     if (state != Result::NONE)
         return state == Result::LOST ? mated_in(ss->ply) : 0;
 
+    stats.inc(Stats::QSEARCH_NODES);
+    stats.depth(Stats::NODES, 0);
+
     Score bestValue = Eval::evaluation(board);
+
+    stats.hit(Stats::QS_STAND_PAT, bestValue >= beta);
     if (bestValue >= beta)
         return bestValue;
     if (bestValue > alpha)
@@ -119,6 +157,7 @@ template <Node node> Score Search::qsearch(Score alpha, Score beta, Stack *ss)
 
     TEntry *tte = TTable.probeTT(ttHit, ttMove, board.hashKey);
     Score ttScore = ttHit ? scoreFromTT(tte->score, ss->ply) : Score(VALUE_NONE);
+    stats.hit(Stats::QS_TT_HIT, ttHit);
     // clang-format off
     if (    ttHit 
         &&  !PvNode 
@@ -142,8 +181,11 @@ template <Node node> Score Search::qsearch(Score alpha, Score beta, Stack *ss)
      * Search the moves
      *******************/
     Move move = NO_MOVE;
+    uint8_t madeMoves = 0;
     while ((move = mp.nextMove()) != NO_MOVE)
     {
+        TTable.prefetchTT(board.keyAfter(move));
+
         PieceType captured = type_of_piece(board.pieceAtB(to(move)));
 
         if (bestValue > VALUE_TB_LOSS_IN_MAX_PLY)
@@ -160,9 +202,13 @@ template <Node node> Score Search::qsearch(Score alpha, Score beta, Stack *ss)
 
             // see based capture pruning
             if (!inCheck && !board.see(move, 0))
+            {
+                stats.depth(Stats::SEE_PRUNED, 0);
                 continue;
+            }
         }
 
+        madeMoves++;
         nodes++;
 
         board.makeMove<true>(move);
@@ -184,7 +230,12 @@ template <Node node> Score Search::qsearch(Score alpha, Score beta, Stack *ss)
                 bestMove = move;
 
                 if (score >= beta)
+                {
+                    stats.depth(Stats::FAIL_HIGH, 0);
+                    stats.depth(Stats::FAIL_HIGH_FIRST, 0, madeMoves == 1);
+                    stats.depth(Stats::CUTOFF_INDEX, 0, madeMoves);
                     break;
+                }
             }
         }
     }
@@ -220,14 +271,12 @@ template <Node node> Score Search::absearch(int depth, Score alpha, Score beta,
     Score staticEval;
     Move excludedMove = ss->excludedMove;
 
-    const bool inCheck = board.isSquareAttacked(~color, board.KingSQ(color));
+    const bool inCheck = board.inCheck();
     bool improving;
 
     if (ss->ply >= MAX_PLY)
         return (ss->ply >= MAX_PLY && !inCheck) ? Eval::evaluation(board) : 0;
 
-    pvLength[ss->ply] = ss->ply;
-
     /********************
      * Draw detection and mate pruning
      *******************/
@@ -278,6 +327,10 @@ template <Node node> Score Search::absearch(int depth, Score alpha, Score beta,
     TEntry *tte = TTable.probeTT(ttHit, ttMove, board.hashKey);
     Score ttScore = ttHit ? scoreFromTT(tte->score, ss->ply) : Score(VALUE_NONE);
 
+    stats.inc(Stats::ABSEARCH_NODES);
+    stats.hit(Stats::TT_HIT, ttHit);
+    stats.depth(Stats::NODES, depth);
+
     /********************
      * Look up in the TT
      * Adjust alpha and beta for non PV nodes
@@ -303,6 +356,17 @@ template <Node node> Score Search::absearch(int depth, Score alpha, Score beta,
             return ttScore;
     }
 
+    /********************
+     *  KPK bitbase probing, drawn positions are exact
+     *******************/
+
+    if (!RootNode && Bitbase::isKPK(board) && !Bitbase::probe(board))
+    {
+        if (!excludedMove)
+            TTable.storeEntry(depth + 6, 0, EXACTBOUND, board.hashKey, NO_MOVE);
+        return 0;
+    }
+
     /********************
      *  Tablebase probing
      *******************/
@@ -391,14 +455,20 @@ template <Node node> Score Search::absearch(int depth, Score alpha, Score beta,
      * Razoring
      *******************/
     if (depth < 3 && staticEval + 129 < alpha)
+    {
+        stats.depth(Stats::RAZOR, depth);
         return qsearch<NonPV>(alpha, beta, ss);
+    }
 
     /********************
      * Reverse futility pruning
      *******************/
     if (std::abs(beta) < VALUE_TB_WIN_IN_MAX_PLY)
         if (depth < 7 && staticEval - 64 * depth + 71 * improving >= beta)
+        {
+            stats.depth(Stats::RFP, depth);
             return beta;
+        }
 
     /********************
      * Null move pruning
@@ -417,6 +487,9 @@ template <Node node> Score Search::absearch(int depth, Score alpha, Score beta,
         (ss)->currentmove = NULL_MOVE;
         Score score = -absearch<NonPV>(depth - R, -beta, -beta + 1, ss + 1);
         board.unmakeNullMove();
+
+        stats.depth(Stats::NMP_TRIED, depth);
+        stats.depth(Stats::NMP_CUTOFF, depth, score >= beta);
         if (score >= beta)
         {
             // dont return mate scores
@@ -427,9 +500,63 @@ template <Node node> Score Search::absearch(int depth, Score alpha, Score beta,
         }
     }
 
+    /********************
+     * ProbCut
+     * If a good capture beats a raised beta in qsearch and
+     * in a reduced search, the node will most likely fail high.
+     *******************/
+    // clang-format off
+    if (    probCut
+        &&  depth >= 5
+        &&  std::abs(beta) < VALUE_TB_WIN_IN_MAX_PLY
+        &&  !(ttHit && tte->depth >= depth - 3 && ttScore != VALUE_NONE && ttScore < beta + 200))
+    {
+        // clang-format on
+        const Score probCutBeta = beta + 200;
+
+        Movelist captures;
+        MovePick<QSEARCH> mp(*this, ss, captures, ttMove);
+        mp.stage = ttHit ? TT_MOVE : GENERATE;
+
+        Move move = NO_MOVE;
+        while ((move = mp.nextMove()) != NO_MOVE)
+        {
+            if (move == excludedMove)
+                continue;
+
+            TTable.prefetchTT(board.keyAfter(move));
+
+            if (!board.see(move, probCutBeta - staticEval))
+                continue;
+
+            nodes++;
+            board.makeMove<true>(move);
+            ss->currentmove = move;
+
+            // verify the capture with a qsearch first, which is much cheaper
+            Score score = -qsearch<NonPV>(-probCutBeta, -probCutBeta + 1, ss + 1);
+
+            if (score >= probCutBeta)
+                score = -absearch<NonPV>(depth - 4, -probCutBeta, -probCutBeta + 1, ss + 1);
+
+            board.unmakeMove<false>(move);
+
+            if (score >= probCutBeta)
+            {
+                stats.depth(Stats::PROBCUT, depth);
+
+                if (!excludedMove)
+                    TTable.storeEntry(depth - 3, scoreToTT(score, ss->ply), LOWERBOUND, board.hashKey, move);
+
+                return score;
+            }
+        }
+    }
+
 moves:
     Movelist moves;
     Move quiets[64];
+    Move pv[PvNode ? MAX_PLY + 1 : 1];
 
     Score score = VALUE_NONE;
     Move bestMove = NO_MOVE;
@@ -438,18 +565,43 @@ moves:
     uint8_t madeMoves = 0;
     bool doFullSearch = false;
 
-    MovePick<ABSEARCH> mp(*this, ss, moves, searchmoves, RootNode, ttMove, ttHit ? TT_MOVE : GENERATE);
+    Move deferredMoves[MAX_DEFERRED];
+    int deferredCount = 0;
+    int deferredIndex = 0;
+
+    const bool useDeferral = deferMoves && !RootNode && depth >= DEFER_DEPTH;
+
+    MovePick<ABSEARCH> mp(*this, ss, moves, RootNode, ttMove, ttHit ? TT_MOVE : GENERATE);
 
     /********************
      * Movepicker fetches the next move that we should search.
      * It is very important to return the likely best move first,
      * since then we get many cut offs.
+     * Moves deferred because another thread searches them are
+     * picked up after all other moves.
      *******************/
-    while ((move = mp.nextMove()) != NO_MOVE)
+    while ((move = mp.nextMove()) != NO_MOVE ||
+           (deferredIndex < deferredCount && (move = deferredMoves[deferredIndex++]) != NO_MOVE))
     {
         if (move == excludedMove)
             continue;
 
+        const U64 searchingKey = useDeferral ? SearchingTable::key(board.hashKey, move) : 0;
+
+        /********************
+         * ABDADA, the first move is always searched, later moves
+         * another thread is already working on are deferred once.
+         *******************/
+        if (useDeferral && madeMoves && !deferredIndex && deferredCount < MAX_DEFERRED &&
+            searchingMoves.isSearching(searchingKey))
+        {
+            deferredMoves[deferredCount++] = move;
+            continue;
+        }
+
+        // start loading the TT entry of the child, the pruning below hides most of the latency
+        TTable.prefetchTT(board.keyAfter(move));
+
         madeMoves++;
 
         int extension = 0;
@@ -467,7 +619,10 @@ moves:
                 // SEE pruning
                 if (    depth < 6 
                     &&  !board.see(move, -(depth * 92)))
+                {
+                    stats.depth(Stats::SEE_PRUNED, depth);
                     continue;
+                }
             }
             else
             {
@@ -477,12 +632,17 @@ moves:
                     &&  !promoted(move) 
                     &&  depth <= 5
                     &&  quietCount > (4 + depth * depth))
-
+                {
+                    stats.depth(Stats::LMP_PRUNED, depth);
                     continue;
+                }
                 // SEE pruning
                 if (    depth < 7 
                     &&  !board.see(move, -(depth * 93)))
+                {
+                    stats.depth(Stats::SEE_PRUNED, depth);
                     continue;
+                }
             }
             // clang-format on
         }
@@ -505,6 +665,9 @@ moves:
             int value = absearch<NonPV>(singularDepth, singularBeta - 1, singularBeta, ss);
             ss->excludedMove = NO_MOVE;
 
+            stats.depth(Stats::SE_TRIED, depth);
+            stats.depth(Stats::SE_EXTENDED, depth, value < singularBeta);
+
             if (value < singularBeta)
                 extension = 1;
             else if (singularBeta >= beta)
@@ -524,9 +687,16 @@ moves:
             &&  getTime() > 10000)
             std::cout << "info depth " << depth - inCheck 
                       << " currmove " << uciMove(move, board.chess960)
-                      << " currmovenumber " << signed(madeMoves) << std::endl;
+                      << " currmovenumber " << signed(madeMoves) + pvIdx << std::endl;
         // clang-format on
 
+        // the pv of the child is collected in our frame
+        if (PvNode)
+        {
+            (ss + 1)->pv = pv;
+            pv[0] = NO_MOVE;
+        }
+
         /********************
          * Play the move on the internal board.
          *******************/
@@ -536,6 +706,9 @@ moves:
         U64 nodeCount = nodes;
         ss->currentmove = move;
 
+        if (useDeferral)
+            searchingMoves.enter(searchingKey);
+
         /********************
          * Late move reduction, later moves will be searched
          * with a reduced depth, if they beat alpha we search again at
@@ -555,6 +728,10 @@ moves:
 
             score = -absearch<NonPV>(rdepth, -alpha - 1, -alpha, ss + 1);
             doFullSearch = score > alpha && rdepth < newDepth;
+
+            stats.depth(Stats::LMR_SEARCHES, depth);
+            stats.depth(Stats::LMR_REDUCTION, depth, newDepth - rdepth);
+            stats.depth(Stats::LMR_RESEARCH, depth, doFullSearch);
         }
         else
             doFullSearch = !PvNode || madeMoves > 1;
@@ -579,13 +756,33 @@ moves:
 
         board.unmakeMove<false>(move);
 
+        if (useDeferral)
+            searchingMoves.leave(searchingKey);
+
         assert(score > -VALUE_INFINITE && score < VALUE_INFINITE);
 
         /********************
-         * Node count logic used for time control.
+         * Update the root move, its node count is used for time control
+         * and the move ordering of the next iteration.
          *******************/
-        if (id == 0)
-            spentEffort[from(move)][to(move)] += nodes - nodeCount;
+        if (RootNode && !aborted())
+        {
+            RootMove &rm = *std::find(rootMoves.begin(), rootMoves.end(), move);
+            rm.nodes += nodes - nodeCount;
+
+            if (madeMoves == 1 || score > alpha)
+            {
+                rm.score = score;
+                rm.pv.assign(1, move);
+
+                for (const Move *next = (ss + 1)->pv; *next != NO_MOVE; next++)
+                    rm.pv.push_back(*next);
+            }
+            else
+            {
+                rm.score = -VALUE_INFINITE;
+            }
+        }
 
         /********************
          * Score beat best -> update PV and Bestmove.
@@ -599,21 +796,18 @@ moves:
                 alpha = score;
                 bestMove = move;
 
-                // update the PV
-                pvTable[ss->ply][ss->ply] = move;
-
-                for (int next_ply = ss->ply + 1; next_ply < pvLength[ss->ply + 1]; next_ply++)
-                {
-                    pvTable[ss->ply][next_ply] = pvTable[ss->ply + 1][next_ply];
-                }
-
-                pvLength[ss->ply] = pvLength[ss->ply + 1];
+                if (PvNode)
+                    updatePv(ss->pv, move, (ss + 1)->pv);
 
                 /********************
                  * Score beat beta -> update histories and break.
                  *******************/
                 if (score >= beta)
                 {
+                    stats.depth(Stats::FAIL_HIGH, depth);
+                    stats.depth(Stats::FAIL_HIGH_FIRST, depth, madeMoves == 1);
+                    stats.depth(Stats::CUTOFF_INDEX, depth, madeMoves);
+
                     // update history heuristic
                     updateAllHistories(bestMove, best, beta, depth, quiets, quietCount, ss);
                     break;
@@ -630,6 +824,8 @@ moves:
     if (madeMoves == 0)
         best = excludedMove ? alpha : inCheck ? mated_in(ss->ply) : 0;
 
+    stats.histogram(Stats::MOVES_SEARCHED, madeMoves);
+
     if (PvNode)
         best = std::min(best, maxValue);
 
@@ -677,10 +873,10 @@ Score Search::aspirationSearch(int depth, Score prevEval, Stack *ss)
 
         result = absearch<Root>(depth, alpha, beta, ss);
 
-        if (stopped.load(std::memory_order_relaxed))
-            return 0;
+        // the best move of a re-search is searched first in the next one
+        std::stable_sort(rootMoves.begin() + pvIdx, rootMoves.end());
 
-        if (id == 0 && limit.nodes != 0 && nodes >= limit.nodes)
+        if (aborted())
             return 0;
 
         /********************
@@ -704,9 +900,8 @@ Score Search::aspirationSearch(int depth, Score prevEval, Stack *ss)
         }
     }
 
-    if (id == 0 && normalSearch)
-        uciOutput(result, depth, seldepth, Threads.getNodes(), Threads.getTbHits(), getTime(), getPV(),
-                  TTable.hashfull());
+    if (id == 0 && normalSearch && pvIdx + 1 == std::min<int>(multiPV, rootMoves.size()))
+        printPVs(depth);
 
     return result;
 }
@@ -720,8 +915,32 @@ SearchResult Search::iterativeDeepening()
     int depth = 1;
 
     Stack stack[MAX_PLY + 4], *ss = stack + 2;
+    Move pv[MAX_PLY + 1] = {NO_MOVE};
+
+    Movelist legalMoves;
+    Movegen::legalmoves<Movetype::ALL>(board, legalMoves);
+
+    rootMoves.clear();
+    for (const auto &ext : legalMoves)
+    {
+        if (searchmoves.size == 0 || searchmoves.find(ext.move()) != -1)
+            rootMoves.emplace_back(ext.move());
+    }
+
+    const int pvCount = std::min<int>(multiPV, rootMoves.size());
+
+    /********************
+     * Without legal moves there is nothing to search.
+     *******************/
+    if (rootMoves.empty())
+    {
+        sr.score = board.inCheck() ? mated_in(0) : 0;
 
-    spentEffort.fill({});
+        if (id == 0 && normalSearch)
+            std::cout << "info depth 0 score " << outputScore(sr.score) << std::endl;
+
+        limit.depth = 0;
+    }
 
     for (int i = -2; i <= MAX_PLY + 1; ++i)
     {
@@ -729,8 +948,11 @@ SearchResult Search::iterativeDeepening()
         (ss + i)->currentmove = NO_MOVE;
         (ss + i)->eval = 0;
         (ss + i)->excludedMove = NO_MOVE;
+        (ss + i)->pv = nullptr;
     }
 
+    ss->pv = pv;
+
     int bestmoveChanges = 0;
     int evalAverage = 0;
 
@@ -739,8 +961,35 @@ SearchResult Search::iterativeDeepening()
      *******************/
     for (depth = 1; depth <= limit.depth; depth++)
     {
-        seldepth = 0;
-        result = aspirationSearch(depth, result, ss);
+        if (skipDepths && id != 0)
+        {
+            const int i = (id - 1) % SKIP_THREADS;
+            if (((depth + SkipPhase[i]) / SkipSize[i]) % 2)
+                continue;
+        }
+
+        for (auto &rm : rootMoves)
+            rm.previousScore = rm.score;
+
+        /********************
+         * Search every pv line, the moves of the earlier lines
+         * are excluded from the root.
+         *******************/
+        for (pvIdx = 0; pvIdx < pvCount; pvIdx++)
+        {
+            seldepth = 0;
+            const Score score = aspirationSearch(depth, pvIdx ? rootMoves[pvIdx].previousScore : result, ss);
+
+            if (pvIdx == 0)
+                result = score;
+
+            if (aborted())
+                break;
+
+            std::stable_sort(rootMoves.begin(), rootMoves.begin() + pvIdx + 1);
+        }
+
+        pvIdx = 0;
         evalAverage += result;
 
         if (limitReached())
@@ -752,10 +1001,10 @@ SearchResult Search::iterativeDeepening()
 
         sr.score = result;
 
-        if (bestmove != pvTable[0][0])
+        if (bestmove != rootMoves[0].move)
             bestmoveChanges++;
 
-        bestmove = pvTable[0][0];
+        bestmove = rootMoves[0].move;
 
         // limit type time
         if (limit.time.optimum != 0)
@@ -763,7 +1012,7 @@ SearchResult Search::iterativeDeepening()
             auto now = getTime();
 
             // node count time management (https://github.com/Luecx/Koivisto 's idea)
-            int effort = (spentEffort[from(bestmove)][to(bestmove)] * 100) / nodes;
+            int effort = (rootMoves[0].nodes * 100) / nodes;
             if (depth > 10 && limit.time.optimum * (110 - std::min(effort, 90)) / 100 < now)
                 break;
 
@@ -788,10 +1037,10 @@ SearchResult Search::iterativeDeepening()
     }
 
     /********************
-     * In case the depth was 1 make sure we have at least a bestmove.
+     * In case the first iteration was not finished make sure we have at least a bestmove.
      *******************/
-    if (depth == 1)
-        bestmove = pvTable[0][0];
+    if (bestmove == NO_MOVE && !rootMoves.empty())
+        bestmove = rootMoves[0].move;
 
     /********************
      * Mainthread prints bestmove.
@@ -803,8 +1052,6 @@ SearchResult Search::iterativeDeepening()
         stopped = true;
     }
 
-    print_mean();
-
     sr.move = bestmove;
     return sr;
 }
@@ -868,13 +1115,38 @@ bool Search::limitReached()
     return false;
 }
 
-std::string Search::getPV()
+bool Search::aborted() const
+{
+    if (normalSearch && stopped.load(std::memory_order_relaxed))
+        return true;
+
+    return id == 0 && limit.nodes != 0 && nodes >= limit.nodes;
+}
+
+void Search::printPVs(int depth)
+{
+    const int pvCount = std::min<int>(multiPV, rootMoves.size());
+
+    for (int i = 0; i < pvCount; i++)
+    {
+        const RootMove &rm = rootMoves[i];
+        const bool updated = rm.score != -VALUE_INFINITE;
+
+        if (!updated && depth == 1)
+            continue;
+
+        uciOutput(updated ? rm.score : rm.previousScore, depth, seldepth, Threads.getNodes(), Threads.getTbHits(),
+                  getTime(), getPV(rm), TTable.hashfull(), multiPV > 1 ? i + 1 : 0);
+    }
+}
+
+std::string Search::getPV(const RootMove &rm)
 {
     std::stringstream ss;
 
-    for (int i = 0; i < pvLength[0]; i++)
+    for (const Move move : rm.pv)
     {
-        ss << " " << uciMove(pvTable[0][i], board.chess960);
+        ss << " " << uciMove(move, board.chess960);
     }
 
     return ss.str();
@@ -891,17 +1163,17 @@ Score Search::probeTB()
     U64 white = board.Us<White>();
     U64 black = board.Us<Black>();
 
-    if (popcount(white | black) > (signed)TB_LARGEST)
+    if (board.count() > (signed)TB_LARGEST)
         return VALUE_NONE;
 
     Square ep = board.enPassantSquare <= 63 ? board.enPassantSquare : Square(0);
 
-    unsigned TBresult = tb_probe_wdl(white, black, board.pieces<WhiteKing>() | board.pieces<BlackKing>(),
-                                     board.pieces<WhiteQueen>() | board.pieces<BlackQueen>(),
-                                     board.pieces<WhiteRook>() | board.pieces<BlackRook>(),
-                                     board.pieces<WhiteBishop>() | board.pieces<BlackBishop>(),
-                                     board.pieces<WhiteKnight>() | board.pieces<BlackKnight>(),
-                                     board.pieces<WhitePawn>() | board.pieces<BlackPawn>(), board.halfMoveClock,
+    unsigned TBresult = tb_probe_wdl(white, black, board.pieces(KING),
+                                     board.pieces(QUEEN),
+                                     board.pieces(ROOK),
+                                     board.pieces(BISHOP),
+                                     board.pieces(KNIGHT),
+                                     board.pieces(PAWN), board.halfMoveClock,
                                      board.castlingRights, ep, board.sideToMove == White);
 
     if (TBresult == TB_LOSS)
@@ -923,17 +1195,17 @@ Move Search::probeDTZ()
 {
     U64 white = board.Us<White>();
     U64 black = board.Us<Black>();
-    if (popcount(white | black) > (signed)TB_LARGEST)
+    if (board.count() > (signed)TB_LARGEST)
         return NO_MOVE;
 
     Square ep = board.enPassantSquare <= 63 ? board.enPassantSquare : Square(0);
 
     unsigned TBresult = tb_probe_root(
-        white, black, board.pieces<WhiteKing>() | board.pieces<BlackKing>(),
-        board.pieces<WhiteQueen>() | board.pieces<BlackQueen>(), board.pieces<WhiteRook>() | board.pieces<BlackRook>(),
-        board.pieces<WhiteBishop>() | board.pieces<BlackBishop>(),
-        board.pieces<WhiteKnight>() | board.pieces<BlackKnight>(),
-        board.pieces<WhitePawn>() | board.pieces<BlackPawn>(), board.halfMoveClock, board.castlingRights, ep,
+        white, black, board.pieces(KING),
+        board.pieces(QUEEN), board.pieces(ROOK),
+        board.pieces(BISHOP),
+        board.pieces(KNIGHT),
+        board.pieces(PAWN), board.halfMoveClock, board.castlingRights, ep,
         board.sideToMove == White, NULL); //  * - turn: true=white, false=black
 
     if (TBresult == TB_RESULT_FAILED || TBresult == TB_RESULT_CHECKMATE || TBresult == TB_RESULT_STALEMATE)
@@ -970,7 +1242,7 @@ Move Search::probeDTZ()
 
     for (auto ext : legalmoves)
     {
-        const Move move = ext.move;
+        const Move move = ext.move();
         if (from(move) == sqFrom && to(move) == sqTo)
         {
             if ((promoTranslation[promo] == NONETYPE && !promoted(move)) ||
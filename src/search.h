@@ -1,25 +1,143 @@
 #pragma once
 
+#include <atomic>
 #include <thread>
+#include <vector>
 
 #include "syzygy/Fathom/src/tbprobe.h"
 
 #include "board.h"
 #include "movegen.h"
+#include "stats.h"
 #include "timemanager.h"
 
 using historyTable = std::array<std::array<std::array<int, MAX_SQ>, MAX_SQ>, 2>;
 using killerTable = std::array<std::array<Move, MAX_PLY + 1>, 2>;
-using nodeTable = std::array<std::array<U64, MAX_SQ>, MAX_SQ>;
+
+/********************
+ * Counter that is only written by its own search thread while other
+ * threads read it, e.g. for the uci output. Relaxed atomics compile to
+ * plain loads and stores, the padding keeps every counter on its own
+ * cache line so the readers never invalidate the writers hot data.
+ *******************/
+struct alignas(64) ThreadCounter
+{
+    ThreadCounter() = default;
+
+    ThreadCounter(const ThreadCounter &other) : value(other.load())
+    {
+    }
+
+    ThreadCounter &operator=(const ThreadCounter &other)
+    {
+        value.store(other.load(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    ThreadCounter &operator=(uint64_t v)
+    {
+        value.store(v, std::memory_order_relaxed);
+        return *this;
+    }
+
+    // only the owning thread increments, so no read-modify-write is needed
+    void operator++(int)
+    {
+        value.store(load() + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    operator uint64_t() const
+    {
+        return load();
+    }
+
+  private:
+    std::atomic<uint64_t> value = 0;
+};
+
+/********************
+ * ABDADA style table of the moves that are currently being searched.
+ * A thread marks a position+move pair before searching it, other threads
+ * defer that move and come back to it after their remaining moves.
+ * Collisions only cause a move to be deferred or searched twice.
+ *******************/
+class SearchingTable
+{
+  public:
+    static U64 key(U64 hashKey, Move move)
+    {
+        return hashKey ^ (U64(move) * 0x9E3779B97F4A7C15ull);
+    }
+
+    bool isSearching(U64 key) const
+    {
+        return table[key & (SIZE - 1)].load(std::memory_order_relaxed) == key;
+    }
+
+    void enter(U64 key)
+    {
+        table[key & (SIZE - 1)].store(key, std::memory_order_relaxed);
+    }
+
+    void leave(U64 key)
+    {
+        table[key & (SIZE - 1)].compare_exchange_strong(key, 0, std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr U64 SIZE = 1 << 15;
+
+    std::array<std::atomic<U64>, SIZE> table = {};
+};
 
 struct Stack
 {
+    // pv of this node, only set in pv nodes
+    Move *pv;
     int eval;
     Move currentmove;
     Move excludedMove;
     uint16_t ply;
 };
 
+/********************
+ * Root moves are kept over all iterations and aspiration re-searches.
+ * After every search of the root they are sorted by their score,
+ * moves that failed low are ordered by the size of their subtree.
+ *******************/
+struct RootMove
+{
+    explicit RootMove(Move m) : move(m), pv(1, m)
+    {
+    }
+
+    bool operator==(const Move m) const
+    {
+        return move == m;
+    }
+
+    bool operator<(const RootMove &other) const
+    {
+        return score != other.score ? score > other.score : nodes > other.nodes;
+    }
+
+    Move move;
+
+    // score of the current and of the last iteration, -VALUE_INFINITE if the move failed low
+    Score score = -VALUE_INFINITE;
+    Score previousScore = -VALUE_INFINITE;
+
+    // nodes spent on this move during the whole search
+    U64 nodes = 0;
+
+    std::vector<Move> pv;
+};
+
 struct SearchResult
 {
     Move move;
@@ -40,21 +158,24 @@ class Search
     // [sideToMove][ply]
     killerTable killerMoves = {};
 
-    // node count logic
-    nodeTable spentEffort = {};
+    // restricts the root moves if not empty
+    Movelist searchmoves = {};
 
-    // pv collection
-    std::array<uint8_t, MAX_PLY> pvLength = {};
-    std::array<std::array<Move, MAX_PLY>, MAX_PLY> pvTable = {};
+    std::vector<RootMove> rootMoves;
 
-    Movelist searchmoves = {};
+    // number of pv lines and the line that is currently searched
+    int multiPV = 1;
+    int pvIdx = 0;
 
     // Mainthread limits
     Limits limit = {};
 
     // nodes searched
-    uint64_t nodes = 0;
-    uint64_t tbhits = 0;
+    ThreadCounter nodes;
+    ThreadCounter tbhits;
+
+    // instrumentation, empty unless compiled with USE_STATS
+    SearchStats stats;
 
     // thread id, Mainthread = 0
     int id = 0;
@@ -71,6 +192,15 @@ class Search
 
     bool useTB = false;
 
+    // defer moves that another thread is searching, only useful with more than one thread
+    bool deferMoves = false;
+
+    // helper threads skip some iterations according to their id
+    bool skipDepths = false;
+
+    // ProbCut stays off until it passed a strength test
+    bool probCut = false;
+
     void startThinking();
 
     // data generation entry function
@@ -100,7 +230,15 @@ class Search
     // check limits
     bool limitReached();
 
-    std::string getPV();
+    /// @brief stop condition of the search, without the time check of limitReached
+    /// @return true if the current iteration was aborted
+    bool aborted() const;
+
+    /// @brief print the uci info of all pv lines
+    /// @param depth
+    void printPVs(int depth);
+
+    std::string getPV(const RootMove &rm);
     int64_t getTime();
 
     // check TB WDL during search
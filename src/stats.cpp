@@ -0,0 +1,159 @@
+#include "stats.h"
+
+#ifdef USE_STATS
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// clang-format off
+static constexpr std::array<const char *, Stats::COUNTER_NB> counterNames = {
+    "absearch nodes",
+    "qsearch nodes"
+};
+
+static constexpr std::array<const char *, Stats::HITRATE_NB> hitRateNames = {
+    "tt hit",
+    "qsearch tt hit",
+    "qsearch stand pat"
+};
+
+static constexpr std::array<const char *, Stats::HISTOGRAM_NB> histogramNames = {
+    "moves searched"
+};
+// clang-format on
+
+void SearchStats::merge(const SearchStats &other)
+{
+    for (int i = 0; i < Stats::COUNTER_NB; i++)
+        counters[i] += other.counters[i];
+
+    for (int i = 0; i < Stats::HITRATE_NB; i++)
+    {
+        hitRates[i][0] += other.hitRates[i][0];
+        hitRates[i][1] += other.hitRates[i][1];
+    }
+
+    for (int i = 0; i < Stats::HISTOGRAM_NB; i++)
+        for (int j = 0; j < Stats::HISTOGRAM_BUCKETS; j++)
+            histograms[i][j] += other.histograms[i][j];
+
+    for (int i = 0; i < Stats::DEPTH_BUCKETS; i++)
+        for (int j = 0; j < Stats::DEPTH_COUNTER_NB; j++)
+            depthCounters[i][j] += other.depthCounters[i][j];
+}
+
+void SearchStats::clear()
+{
+    *this = SearchStats();
+}
+
+void SearchStats::print() const
+{
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (int i = 0; i < Stats::COUNTER_NB; i++)
+        std::cout << std::left << std::setw(24) << counterNames[i] << counters[i] << "\n";
+
+    for (int i = 0; i < Stats::HITRATE_NB; i++)
+    {
+        const int64_t total = hitRates[i][0];
+        std::cout << std::left << std::setw(24) << hitRateNames[i] << "total " << total << " hits "
+                  << hitRates[i][1] << " rate " << (total ? 100.0 * hitRates[i][1] / total : 0.0) << "%\n";
+    }
+
+    for (int i = 0; i < Stats::HISTOGRAM_NB; i++)
+    {
+        int64_t total = 0;
+        double sum = 0;
+
+        for (int j = 0; j < Stats::HISTOGRAM_BUCKETS; j++)
+        {
+            total += histograms[i][j];
+            sum += double(j) * histograms[i][j];
+        }
+
+        std::cout << histogramNames[i] << " (total " << total << " mean " << (total ? sum / total : 0.0) << ")\n";
+
+        for (int j = 0; j < Stats::HISTOGRAM_BUCKETS; j++)
+        {
+            if (!histograms[i][j])
+                continue;
+
+            std::cout << "  " << std::right << std::setw(3) << j << (j == Stats::HISTOGRAM_BUCKETS - 1 ? "+ " : "  ")
+                      << std::setw(12) << histograms[i][j] << std::setw(8)
+                      << 100.0 * histograms[i][j] / total << "%\n";
+        }
+    }
+
+    printDepthReport();
+
+    std::cout << std::right << std::defaultfloat << std::flush;
+}
+
+static double ratio(int64_t a, int64_t b, double scale = 100.0)
+{
+    return b ? scale * a / b : 0.0;
+}
+
+/********************
+ * One row per depth:
+ * fh%    nodes failing high
+ * fh1st% fail highs on the first move
+ * cutidx average move index of a fail high
+ * nmp%   null move searches failing high
+ * se%    singular searches that extended
+ * lmr    late move reduced searches, R their average reduction
+ * re%    reduced searches that had to be re-searched
+ *******************/
+void SearchStats::printDepthReport() const
+{
+    using namespace Stats;
+
+    std::array<int64_t, DEPTH_COUNTER_NB> total = {};
+
+    auto printRow = [](const std::string &depth, const std::array<int64_t, DEPTH_COUNTER_NB> &c) {
+        // clang-format off
+        std::cout << std::setw(6)  << depth
+                  << std::setw(12) << c[NODES]
+                  << std::setw(8)  << ratio(c[FAIL_HIGH], c[NODES])
+                  << std::setw(8)  << ratio(c[FAIL_HIGH_FIRST], c[FAIL_HIGH])
+                  << std::setw(8)  << ratio(c[CUTOFF_INDEX], c[FAIL_HIGH], 1.0)
+                  << std::setw(8)  << ratio(c[NMP_CUTOFF], c[NMP_TRIED])
+                  << std::setw(10) << c[RAZOR]
+                  << std::setw(10) << c[RFP]
+                  << std::setw(10) << c[PROBCUT]
+                  << std::setw(10) << c[SEE_PRUNED]
+                  << std::setw(10) << c[LMP_PRUNED]
+                  << std::setw(8)  << ratio(c[SE_EXTENDED], c[SE_TRIED])
+                  << std::setw(10) << c[LMR_SEARCHES]
+                  << std::setw(6)  << ratio(c[LMR_REDUCTION], c[LMR_SEARCHES], 1.0)
+                  << std::setw(8)  << ratio(c[LMR_RESEARCH], c[LMR_SEARCHES])
+                  << "\n";
+        // clang-format on
+    };
+
+    std::cout << std::right << "\n"
+              << std::setw(6) << "depth" << std::setw(12) << "nodes" << std::setw(8) << "fh%" << std::setw(8)
+              << "fh1st%" << std::setw(8) << "cutidx" << std::setw(8) << "nmp%" << std::setw(10) << "razor"
+              << std::setw(10) << "rfp" << std::setw(10) << "probcut" << std::setw(10) << "see" << std::setw(10) << "lmp" << std::setw(8) << "se%"
+              << std::setw(10) << "lmr" << std::setw(6) << "R" << std::setw(8) << "re%"
+              << "\n";
+
+    for (int d = 0; d < DEPTH_BUCKETS; d++)
+    {
+        const auto &c = depthCounters[d];
+
+        for (int i = 0; i < DEPTH_COUNTER_NB; i++)
+            total[i] += c[i];
+
+        if (!c[NODES])
+            continue;
+
+        printRow(d == DEPTH_BUCKETS - 1 ? std::to_string(d) + "+" : std::to_string(d), c);
+    }
+
+    printRow("all", total);
+}
+
+#endif
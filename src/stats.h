@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+/********************
+ * Search instrumentation, enabled with "make stats=yes".
+ * Every search thread owns its own collector, the thread pool merges
+ * them once the search is stopped. Without USE_STATS all probes are
+ * empty inline functions and compile to nothing.
+ *******************/
+namespace Stats
+{
+
+// clang-format off
+enum Counter : int
+{
+    ABSEARCH_NODES,
+    QSEARCH_NODES,
+    COUNTER_NB
+};
+
+enum HitRate : int
+{
+    TT_HIT,
+    QS_TT_HIT,
+    QS_STAND_PAT,
+    HITRATE_NB
+};
+
+enum Histogram : int
+{
+    MOVES_SEARCHED,
+    HISTOGRAM_NB
+};
+// clang-format on
+
+/********************
+ * Counters bucketed by the remaining depth,
+ * qsearch nodes are collected at depth 0.
+ *******************/
+enum DepthCounter : int
+{
+    NODES,
+    FAIL_HIGH,
+    FAIL_HIGH_FIRST,
+    CUTOFF_INDEX,
+    NMP_TRIED,
+    NMP_CUTOFF,
+    RAZOR,
+    RFP,
+    PROBCUT,
+    SEE_PRUNED,
+    LMP_PRUNED,
+    SE_TRIED,
+    SE_EXTENDED,
+    LMR_SEARCHES,
+    LMR_REDUCTION,
+    LMR_RESEARCH,
+    DEPTH_COUNTER_NB
+};
+
+// the last bucket collects all larger values
+static constexpr int HISTOGRAM_BUCKETS = 32;
+static constexpr int DEPTH_BUCKETS = 32;
+
+} // namespace Stats
+
+#ifdef USE_STATS
+
+class SearchStats
+{
+  public:
+    static constexpr bool enabled = true;
+
+    void inc(Stats::Counter c, int64_t value = 1)
+    {
+        counters[c] += value;
+    }
+
+    void hit(Stats::HitRate h, bool condition)
+    {
+        hitRates[h][0]++;
+        hitRates[h][1] += condition;
+    }
+
+    void histogram(Stats::Histogram h, int value)
+    {
+        histograms[h][std::clamp(value, 0, Stats::HISTOGRAM_BUCKETS - 1)]++;
+    }
+
+    void depth(Stats::DepthCounter c, int depth, int64_t value = 1)
+    {
+        depthCounters[std::clamp(depth, 0, Stats::DEPTH_BUCKETS - 1)][c] += value;
+    }
+
+    /// @brief add the data of another collector
+    /// @param other
+    void merge(const SearchStats &other);
+
+    int64_t get(Stats::Counter c) const
+    {
+        return counters[c];
+    }
+
+    void clear();
+
+    void print() const;
+
+  private:
+    std::array<int64_t, Stats::COUNTER_NB> counters = {};
+
+    // [probe][total, hits]
+    std::array<std::array<int64_t, 2>, Stats::HITRATE_NB> hitRates = {};
+
+    std::array<std::array<int64_t, Stats::HISTOGRAM_BUCKETS>, Stats::HISTOGRAM_NB> histograms = {};
+
+    // [depth][counter]
+    std::array<std::array<int64_t, Stats::DEPTH_COUNTER_NB>, Stats::DEPTH_BUCKETS> depthCounters = {};
+
+    /// @brief print the per depth report of the pruning and move ordering counters
+    void printDepthReport() const;
+};
+
+#else
+
+class SearchStats
+{
+  public:
+    static constexpr bool enabled = false;
+
+    void inc(Stats::Counter, int64_t = 1)
+    {
+    }
+
+    void hit(Stats::HitRate, bool)
+    {
+    }
+
+    void histogram(Stats::Histogram, int)
+    {
+    }
+
+    void depth(Stats::DepthCounter, int, int64_t = 1)
+    {
+    }
+
+    void merge(const SearchStats &)
+    {
+    }
+
+    int64_t get(Stats::Counter) const
+    {
+        return 0;
+    }
+
+    void clear()
+    {
+    }
+
+    void print() const
+    {
+    }
+};
+
+#endif
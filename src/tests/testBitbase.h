@@ -0,0 +1,48 @@
+#pragma once
+#include "../bitbase.h"
+#include "tests.h"
+
+namespace Tests
+{
+inline void testAllBitbase()
+{
+    Board b;
+
+    // king on the sixth rank in front of the pawn
+    b.applyFen("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1");
+    expect(Bitbase::probe(b), true, "KPK king in front btm");
+
+    b.applyFen("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1");
+    expect(Bitbase::probe(b), true, "KPK king in front wtm");
+
+    // unstoppable pawn
+    b.applyFen("8/4P3/8/8/8/8/k7/7K w - - 0 1");
+    expect(Bitbase::probe(b), true, "KPK unstoppable pawn");
+
+    // stalemate
+    b.applyFen("4k3/4P3/4K3/8/8/8/8/8 b - - 0 1");
+    expect(Bitbase::probe(b), false, "KPK stalemate");
+
+    // lone king captures the pawn
+    b.applyFen("8/8/8/8/8/3k4/4P3/7K b - - 0 1");
+    expect(Bitbase::probe(b), false, "KPK pawn capture");
+
+    // rook pawn with the lone king in the corner
+    b.applyFen("k7/8/8/8/8/8/P7/7K w - - 0 1");
+    expect(Bitbase::probe(b), false, "KPK rook pawn a-file");
+
+    b.applyFen("7k/8/8/8/8/8/7P/K7 w - - 0 1");
+    expect(Bitbase::probe(b), false, "KPK rook pawn h-file");
+
+    // black pawn side
+    b.applyFen("8/8/8/8/4p3/4k3/8/4K3 w - - 0 1");
+    expect(Bitbase::probe(b), true, "KPK black pawn side");
+
+    b.applyFen("8/8/8/8/8/4k3/4p3/4K3 w - - 0 1");
+    expect(Bitbase::probe(b), false, "KPK black pawn side stalemate");
+
+    // not a KPK position
+    b.applyFen("4k3/8/4K3/4P3/8/8/8/7N w - - 0 1");
+    expect(Bitbase::isKPK(b), false, "KNPK");
+}
+} // namespace Tests
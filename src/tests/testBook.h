@@ -0,0 +1,39 @@
+#pragma once
+#include "../book.h"
+#include "tests.h"
+
+namespace Tests
+{
+inline void testAllBook()
+{
+    // reference keys from the polyglot book format specification
+    // clang-format off
+    const std::vector<std::pair<std::string, U64>> positions = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",             0x463b96181691fc9c},
+        {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",          0x823c9b50fd114196},
+        {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2",        0x0756b94461c50fb0},
+        {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2",          0x662fafb965db29d4},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",        0x22a48b5a8e47ff78},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3",           0x652a607ca3f242c1},
+        {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4",            0x00fdd303c946bdd9},
+        {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3",        0x3c8123ea7b067637},
+        {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4",         0x5c3f9b829b279560},
+        {"r1bqk1nr/pppp1ppp/2n5/2b1p3/2B1P3/5N2/PPPP1PPP/RNBQ1RK1 b kq - 5 4",   0xc8162c4989019aab},
+    };
+    // clang-format on
+
+    Board b;
+
+    for (const auto &[fen, key] : positions)
+    {
+        b.applyFen(fen);
+        expect(PolyglotBook::polyglotKey(b), key, fen);
+    }
+
+    // the incremental key must agree after castling, 1.e4 e5 2.Nf3 Nc6 3.Bc4 Bc5 4.O-O
+    b.applyFen(DEFAULT_POS);
+    for (const std::string move : {"e2e4", "e7e5", "g1f3", "b8c6", "f1c4", "f8c5", "e1g1"})
+        b.makeMove<false>(convertUciToMove(b, move));
+    expect(PolyglotBook::polyglotKey(b), 0xc8162c4989019aab, "e2e4 e7e5 g1f3 b8c6 f1c4 f8c5 e1g1");
+}
+} // namespace Tests
@@ -7,8 +7,10 @@ bool testIsPseudoLegalAndIsLegal(const std::string &fen)
     Board b;
     b.applyFen(fen);
 
+    // generate on a copy, so the first isLegal call has to compute the pin and check masks
+    Board copy = b;
     Movelist moves;
-    Movegen::legalmoves<Movetype::ALL>(b, moves);
+    Movegen::legalmoves<Movetype::ALL>(copy, moves);
 
     for (size_t i = 0; i < 65536; i++)
     {
@@ -29,6 +31,41 @@ bool testIsPseudoLegalAndIsLegal(const std::string &fen)
     return true;
 }
 
+/// @brief compare countLegal and hasLegalMoves with the generated moves,
+/// in the position and after every legal move
+bool testCountLegal(const std::string &fen)
+{
+    Board b;
+    b.applyFen(fen);
+
+    Movelist moves;
+    Movegen::legalmoves<Movetype::ALL>(b, moves);
+
+    if (Movegen::countLegal(b) != moves.size || Movegen::hasLegalMoves(b) != (moves.size > 0))
+        return false;
+
+    for (const auto &ext : moves)
+    {
+        b.makeMove<false>(ext.move());
+
+        Movelist replies;
+        Movegen::legalmoves<Movetype::ALL>(b, replies);
+
+        const bool correct =
+            Movegen::countLegal(b) == replies.size && Movegen::hasLegalMoves(b) == (replies.size > 0);
+
+        b.unmakeMove<false>(ext.move());
+
+        if (!correct)
+        {
+            std::cout << uciMove(ext.move(), b.chess960) << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void testAllMoveLegality()
 {
     std::vector<std::string> tests = {DEFAULT_POS,
@@ -46,7 +83,9 @@ void testAllMoveLegality()
                                       "3r2k1/2r2ppp/p3p1b1/B2p4/3NnP2/P7/6PP/4QR1K b - - 2 25"
                                       "4nk2/pp1r1pp1/4b2n/1Pp5/P1P3PB/5N1P/8/KB2R3 w - - 3 38",
                                       "3n4/5k2/6p1/1P1b2P1/P7/2K5/8/4R3 b - - 2 52",
-                                      "r1bqk1r1/1p1p1n2/p1n2pN1/2p1b2Q/2P1Pp2/1PN5/PB4PP/R4RK1 w q - 0 1"};
+                                      "r1bqk1r1/1p1p1n2/p1n2pN1/2p1b2Q/2P1Pp2/1PN5/PB4PP/R4RK1 w q - 0 1",
+                                      "4k3/8/8/8/1b6/8/3N4/4K2r w - - 0 1",
+                                      "4k3/8/8/8/7b/8/4r3/R3K3 w Q - 0 1"};
 
     std::vector<std::string> tests960 = {DEFAULT_POS,
                                          "1rqbkrbn/1ppppp1p/1n6/p1N3p1/8/2P4P/PP1PPPP1/1RQBKRBN w FBfb - 0 9",
@@ -55,13 +94,18 @@ void testAllMoveLegality()
                                          "4rrb1/1kp3b1/1p1p4/pP1Pn2p/5p2/1PR2P2/2P1NB1P/2KR1B2 w D - 0 21",
                                          "1rkr3b/1ppn3p/3pB1n1/6q1/R2P4/4N1P1/1P5P/2KRQ1B1 b Dbd - 0 14"};
 
+    // only pawn moves are legal
+    tests.push_back("k7/8/8/8/8/8/P1q5/K7 w - - 0 1");
+
     for (auto &fen : tests)
     {
         expect(testIsPseudoLegalAndIsLegal(fen), true, fen);
+        expect(testCountLegal(fen), true, fen);
     }
 
     for (auto &fen : tests960)
     {
         expect(testIsPseudoLegalAndIsLegal(fen), true, fen);
+        expect(testCountLegal(fen), true, fen);
     }
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include "tests.h"
+
+namespace Tests
+{
+inline void testAllSee()
+{
+    struct SeeTest
+    {
+        std::string fen;
+        std::string move;
+        int threshold;
+        bool expected;
+    };
+
+    // clang-format off
+    const std::vector<SeeTest> positions = {
+        // undefended pawn
+        {"4k3/8/8/3p4/8/8/8/3RK3 w - - 0 1",            "d1d5",  100, true},
+        {"4k3/8/8/3p4/8/8/8/3RK3 w - - 0 1",            "d1d5",  101, false},
+        // pawn defended by a pawn
+        {"4k3/8/4p3/3p4/8/8/8/3RK3 w - - 0 1",          "d1d5", -400, true},
+        {"4k3/8/4p3/3p4/8/8/8/3RK3 w - - 0 1",          "d1d5", -399, false},
+        // rook behind rook, black does not recapture
+        {"4k3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1",        "d2d5",   50, true},
+        {"4k3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1",        "d2d5",  150, false},
+        // doubled rooks on both sides
+        {"3rk3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1",       "d2d5", -450, true},
+        {"3rk3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1",       "d2d5", -350, false},
+        // queen behind bishop
+        {"4k3/8/2b5/3p4/8/5B2/6Q1/4K3 w - - 0 1",       "f3d5",   50, true},
+        {"4k3/8/2b5/3p4/8/5B2/6Q1/4K3 w - - 0 1",       "f3d5",  150, false},
+        // the king can only recapture if the square is not defended
+        {"8/8/4k3/3p4/8/8/8/3RK3 w - - 0 1",            "d1d5", -450, true},
+        {"8/8/4k3/3p4/8/8/8/3RK3 w - - 0 1",            "d1d5",    0, false},
+        {"8/8/4k3/3p4/8/8/3R4/3RK3 w - - 0 1",          "d2d5",   50, true},
+        {"8/8/4k3/3p4/8/8/3R4/3RK3 w - - 0 1",          "d2d5",  150, false},
+        // quiet move to a square attacked by a pawn
+        {"4k3/8/8/3p4/8/8/1N6/4K3 w - - 0 1",           "b2c4", -350, true},
+        {"4k3/8/8/3p4/8/8/1N6/4K3 w - - 0 1",           "b2c4",    0, false},
+    };
+    // clang-format on
+
+    Board b;
+
+    for (const auto &[fen, uci, threshold, expected] : positions)
+    {
+        b.applyFen(fen);
+        expect(b.see(convertUciToMove(b, uci), threshold), expected,
+               fen + " " + uci + " " + std::to_string(threshold));
+    }
+}
+} // namespace Tests
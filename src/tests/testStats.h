@@ -0,0 +1,32 @@
+#pragma once
+#include "../thread.h"
+#include "tests.h"
+
+extern ThreadPool Threads;
+
+namespace Tests
+{
+inline void testAllStats()
+{
+    if (!SearchStats::enabled)
+        return;
+
+    Limits limit;
+    limit.depth = 6;
+    limit.nodes = 0;
+    limit.time = Time();
+
+    Board b;
+    b.applyFen(DEFAULT_POS);
+
+    // the report must include a search that finished without a stop command
+    Threads.start_threads(b, limit, Movelist(), 1, false);
+    Threads.wait_threads();
+
+    const bool searched = Threads.collectStats().get(Stats::ABSEARCH_NODES) > 0;
+    expect(searched, true, "go depth 6, stats");
+
+    // a second report only holds what was searched since the first one
+    expect(Threads.collectStats().get(Stats::ABSEARCH_NODES), 0, "stats");
+}
+} // namespace Tests
@@ -3,6 +3,55 @@
 
 namespace Tests
 {
+/// @brief compare the incremental material key and piece counts with a recomputation
+inline bool materialMatches(const Board &b)
+{
+    for (Piece p = WhitePawn; p < None; p = Piece(p + 1))
+    {
+        if (b.count(p) != popcount(b.pieces(type_of_piece(p), Color(p / 6))))
+            return false;
+    }
+
+    return b.materialKey == b.materialHash() && b.count() == popcount(b.All());
+}
+
+inline void testAllMaterialKey()
+{
+    Board b;
+    b.applyFen(DEFAULT_POS);
+
+    const U64 startKey = b.materialKey;
+
+    // quiet moves keep the material
+    b.makeMove<false>(convertUciToMove(b, "g1f3"));
+    expect(b.materialKey, startKey, "Startpos g1f3");
+
+    // captures, en passant, promotions and more pieces of one kind than a game can reach,
+    // in the position and after every move
+    for (const std::string fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                                  "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+                                  "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                                  "k7/8/8/8/8/PPPPPPPP/PPPPPPPP/K7 w - - 0 1"})
+    {
+        b.applyFen(fen);
+        expect(materialMatches(b), true, fen);
+
+        Movelist moves;
+        Movegen::legalmoves<Movetype::ALL>(b, moves);
+
+        for (const auto &ext : moves)
+        {
+            const U64 key = b.materialKey;
+
+            b.makeMove<false>(ext.move());
+            expect(materialMatches(b), true, fen + " " + uciMove(ext.move(), false));
+            b.unmakeMove<false>(ext.move());
+
+            expect(b.materialKey, key, fen + " " + uciMove(ext.move(), false));
+        }
+    }
+}
+
 inline bool testAllZobristHash()
 {
     Board b;
@@ -40,6 +89,42 @@ inline bool testAllZobristHash()
     b.makeMove<false>(convertUciToMove(b, "a1a3"));
     expect(b.zobristHash(), 0x5c3f9b829b279560, "a2a4 b7b5 h2h4 b5b4 c2c4 b4c3 a1a3");
 
+    // castling moves are encoded as king takes rook
+    for (const auto &[fen, move] : {std::pair<std::string, std::string>{
+                                        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", "e1g1"},
+                                    {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", "e1c1"}})
+    {
+        b.applyFen(fen);
+        b.makeMove<false>(convertUciToMove(b, move));
+        expect(b.hashKey, b.zobristHash(), fen + " " + move);
+    }
+
+    // the key after a move is exact unless the castling rights change or an en passant square is set
+    for (const std::string fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                                  "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+                                  "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"})
+    {
+        b.applyFen(fen);
+
+        Movelist moves;
+        Movegen::legalmoves<Movetype::ALL>(b, moves);
+
+        for (const auto &ext : moves)
+        {
+            const U64 expected = b.keyAfter(ext.move());
+            const uint8_t castlingRights = b.castlingRights;
+
+            b.makeMove<false>(ext.move());
+
+            if (b.castlingRights == castlingRights && b.enPassantSquare == NO_SQ)
+                expect(b.hashKey, expected, fen + " " + uciMove(ext.move(), false));
+
+            b.unmakeMove<false>(ext.move());
+        }
+    }
+
+    testAllMaterialKey();
+
     return true;
 }
 } // namespace Tests
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "tests.h"
+#include "testBitbase.h"
+#include "testBook.h"
 #include "testDraw.h"
 #include "testFenRepetition.h"
 #include "testMoveLegality.h"
+#include "testSee.h"
+#include "testStats.h"
 #include "testZobristHash.h"
 
 namespace Tests
@@ -13,6 +17,10 @@ bool testAll()
     testAllZobristHash();
     testAllDraw();
     testAllMoveLegality();
+    testAllBitbase();
+    testAllBook();
+    testAllSee();
+    testAllStats();
 
     std::cout << "Tests run successfully" << std::endl;
     return true;
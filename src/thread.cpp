@@ -14,9 +14,9 @@ uint64_t ThreadPool::getNodes()
 {
     uint64_t total = 0;
 
-    for (auto &th : pool)
+    for (const auto &th : pool)
     {
-        total += th.search.nodes;
+        total += th.search.nodes.load();
     }
 
     return total;
@@ -26,9 +26,9 @@ uint64_t ThreadPool::getTbHits()
 {
     uint64_t total = 0;
 
-    for (auto &th : pool)
+    for (const auto &th : pool)
     {
-        total += th.search.tbhits;
+        total += th.search.tbhits.load();
     }
 
     return total;
@@ -48,6 +48,13 @@ void ThreadPool::start_threads(const Board &board, const Limits &limit, const Mo
 
     pool.clear();
 
+    if (workerCount != printedThreads || binding != printedBinding)
+    {
+        Numa::printPlacement(workerCount, binding);
+        printedThreads = workerCount;
+        printedBinding = binding;
+    }
+
     // update with info
     mainThread.search.id = 0;
     mainThread.search.board = board;
@@ -55,8 +62,12 @@ void ThreadPool::start_threads(const Board &board, const Limits &limit, const Mo
     mainThread.search.useTB = useTB;
     mainThread.search.nodes = 0;
     mainThread.search.tbhits = 0;
-    mainThread.search.spentEffort.fill({});
+    mainThread.search.stats.clear();
     mainThread.search.searchmoves = searchmoves;
+    mainThread.search.multiPV = multiPV;
+    mainThread.search.deferMoves = workerCount > 1;
+    mainThread.search.skipDepths = skipDepths;
+    mainThread.search.probCut = probCut;
 
     pool.emplace_back(mainThread);
 
@@ -71,18 +82,45 @@ void ThreadPool::start_threads(const Board &board, const Limits &limit, const Mo
 
     for (int i = 0; i < workerCount; i++)
     {
-        runningThreads.emplace_back(&Thread::start_thinking, std::ref(pool[i]));
+        runningThreads.emplace_back([this, i] {
+            if (!Numa::bindThread(i, binding))
+                std::cout << "info string failed to bind thread " << i << std::endl;
+            else if (binding != Numa::Binding::NONE && Numa::nodes().size() > 1)
+                pool[i].search.board.nnueWeights = NNUE::localInputWeights(Numa::nodeOf(i, binding));
+
+            pool[i].start_thinking();
+        });
     }
 }
 
-void ThreadPool::stop_threads()
+void ThreadPool::wait_threads()
 {
-    stopped = UCI_FORCE_STOP = true;
-
     for (auto &th : runningThreads)
         if (th.joinable())
             th.join();
 
-    pool.clear();
     runningThreads.clear();
 }
+
+void ThreadPool::stop_threads()
+{
+    stopped = UCI_FORCE_STOP = true;
+
+    wait_threads();
+
+    for (auto &th : pool)
+        stats.merge(th.search.stats);
+
+    pool.clear();
+}
+
+SearchStats ThreadPool::collectStats()
+{
+    // a search that ended on its own still holds its data in the pool
+    stop_threads();
+
+    SearchStats collected = stats;
+    stats.clear();
+
+    return collected;
+}
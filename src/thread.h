@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "board.h"
+#include "numa.h"
 #include "search.h"
 
 // A wrapper class to start the search
@@ -24,11 +25,35 @@ class ThreadPool
     std::vector<Thread> pool;
     std::vector<std::thread> runningThreads;
 
+    // instrumentation of all finished searches
+    SearchStats stats;
+
+    // placement of the search threads on the cpus
+    Numa::Binding binding = Numa::Binding::NONE;
+
+    // the placement that was last printed, printed again once it changes
+    int printedThreads = 0;
+    Numa::Binding printedBinding = Numa::Binding::NONE;
+
+    // spread the helper threads over different depths
+    bool skipDepths = true;
+
+    bool probCut = false;
+
+    int multiPV = 1;
+
     uint64_t getNodes();
     uint64_t getTbHits();
 
     void start_threads(const Board &board, const Limits &limit, const Movelist &searchmoves, int workerCount,
                        bool useTB);
 
+    /// @brief wait until all threads have finished their search, the thread data stays available
+    void wait_threads();
+
     void stop_threads();
+
+    /// @brief stop the search and hand out the statistics of all finished searches
+    /// @return the merged statistics, the pool starts collecting from scratch
+    SearchStats collectStats();
 };
\ No newline at end of file
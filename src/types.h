@@ -131,13 +131,15 @@ enum Direction : int8_t
     SOUTH_EAST = -7
 };
 
+// move ordering scores, they are packed into 16 bits of an ExtMove,
+// quiet moves are ordered by their history which stays within [-16384, 16384]
 enum MoveScores : int
 {
-    PROMOTION_SCORE = 9'000'000,
-    CAPTURE_SCORE = 7'000'000,
-    KILLER_ONE_SCORE = 6'000'000,
-    KILLER_TWO_SCORE = 5'000'000,
-    NEGATIVE_SCORE = -10'000'000
+    PROMOTION_SCORE = 24'000,
+    CAPTURE_SCORE = 22'000,
+    KILLER_ONE_SCORE = 21'000,
+    KILLER_TWO_SCORE = 20'000,
+    NEGATIVE_SCORE = -30'000
 };
 
 enum Staging
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "uci.h"
 #include "evaluation.h"
 #include "helper.h"
@@ -22,6 +24,8 @@ uciOptions options = uciOptions();
 UCI::UCI()
 {
     useTB = false;
+    ownBook = false;
+    bookBestMove = false;
 
     threadCount = 1;
 
@@ -96,10 +100,24 @@ void UCI::processCommand(std::string command)
             options.uciEvalFile(value);
         else if (option == "Threads")
             threadCount = options.uciThreads(std::stoi(value));
+        else if (option == "MultiPV")
+            Threads.multiPV = std::clamp(std::stoi(value), 1, MAX_MOVES);
+        else if (option == "HelperDepthSkip")
+            Threads.skipDepths = value == "true";
+        else if (option == "ProbCut")
+            Threads.probCut = value == "true";
+        else if (option == "ThreadBinding")
+            Threads.binding = options.uciThreadBinding(value);
         else if (option == "SyzygyPath")
             useTB = options.uciSyzygy(command);
         else if (option == "UCI_Chess960")
             options.uciChess960(board, value);
+        else if (option == "OwnBook")
+            ownBook = value == "true";
+        else if (option == "BookFile")
+            options.uciBookFile(book, command);
+        else if (option == "BookBestMove")
+            bookBestMove = value == "true";
     }
     else if (tokens[0] == "position")
     {
@@ -126,7 +144,7 @@ void UCI::processCommand(std::string command)
         Movegen::legalmoves<Movetype::CAPTURE>(board, moves);
 
         for (auto ext : moves)
-            std::cout << uciMove(ext.move, board.chess960) << std::endl;
+            std::cout << uciMove(ext.move(), board.chess960) << std::endl;
 
         std::cout << "count: " << signed(moves.size) << std::endl;
     }
@@ -136,7 +154,7 @@ void UCI::processCommand(std::string command)
         Movegen::legalmoves<Movetype::ALL>(board, moves);
 
         for (auto ext : moves)
-            std::cout << uciMove(ext.move, board.chess960) << std::endl;
+            std::cout << uciMove(ext.move(), board.chess960) << std::endl;
 
         std::cout << "count: " << signed(moves.size) << std::endl;
     }
@@ -151,6 +169,14 @@ void UCI::processCommand(std::string command)
         std::cout << Eval::evaluation(board) << std::endl;
     }
 
+    else if (command == "stats")
+    {
+        if (!SearchStats::enabled)
+            std::cout << "Statistics are disabled, compile with stats=yes" << std::endl;
+
+        Threads.collectStats().print();
+    }
+
     else if (command == "perft")
     {
         Perft perft = Perft();
@@ -208,7 +234,34 @@ bool UCI::parseArgs(int argc, char **argv, uciOptions options)
 
     if (contains(allArgs, "bench"))
     {
-        Bench::startBench(contains(allArgs, "depth") ? findElement<int>("depth", allArgs) : 12);
+        if (contains(allArgs, "smp"))
+        {
+            const int threads = contains(allArgs, "threads") ? findElement<int>("threads", allArgs)
+                                                              : std::max(1u, std::thread::hardware_concurrency());
+            Threads.skipDepths = !contains(allArgs, "noskip");
+            Threads.probCut = contains(allArgs, "probcut");
+            Bench::startBenchSmp(contains(allArgs, "depth") ? findElement<int>("depth", allArgs) : 12, threads);
+            quit();
+            return true;
+        }
+
+        if (contains(allArgs, "see"))
+        {
+            Bench::startBenchSee(contains(allArgs, "iterations") ? findElement<int>("iterations", allArgs) : 2000);
+            quit();
+            return true;
+        }
+
+        if (contains(allArgs, "movegen"))
+        {
+            Bench::startBenchMovegen(contains(allArgs, "iterations") ? findElement<int>("iterations", allArgs)
+                                                                      : 20000);
+            quit();
+            return true;
+        }
+
+        Bench::startBench(contains(allArgs, "depth") ? findElement<int>("depth", allArgs) : 12,
+                          contains(allArgs, "perf"), contains(allArgs, "probcut"));
         quit();
         return true;
     }
@@ -220,6 +273,13 @@ bool UCI::parseArgs(int argc, char **argv, uciOptions options)
 
         Perft perft = Perft();
         perft.board = board;
+
+        if (contains(allArgs, "-threads"))
+            perft.threads = std::max(1, findElement<int>("-threads", allArgs));
+
+        if (contains(allArgs, "-hash"))
+            perft.setHash(std::max(0, findElement<int>("-hash", allArgs)));
+
         perft.testAllPos(n);
         quit();
         return true;
@@ -423,6 +483,18 @@ void UCI::startSearch(const std::vector<std::string> &tokens, const std::string
         info.time = optimumTime(timegiven, inc, mtg);
     }
 
+    // play book moves without searching, unless we are asked to analyse
+    if (ownBook && limit != "infinite" && command != "go")
+    {
+        const Move bookMove = book.probe(board, bookBestMove);
+
+        if (bookMove != NO_MOVE && (searchmoves.size == 0 || searchmoves.find(bookMove) != -1))
+        {
+            std::cout << "bestmove " << uciMove(bookMove, board.chess960) << std::endl;
+            return;
+        }
+    }
+
     // start search
     Threads.start_threads(board, info, searchmoves, threadCount, useTB);
 }
@@ -2,6 +2,7 @@
 
 #include "benchmark.h"
 #include "board.h"
+#include "book.h"
 #include "datagen.h"
 #include "timemanager.h"
 #include "ucioptions.h"
@@ -40,8 +41,12 @@ class UCI
 
     Movelist searchmoves;
 
+    PolyglotBook book;
+
     int threadCount;
     bool useTB;
+    bool ownBook;
+    bool bookBestMove;
 
     /// @brief parse custom engine commands
     /// @param argc
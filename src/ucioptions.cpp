@@ -2,11 +2,18 @@
 
 // clang-format off
 std::vector<optionType> optionsPrint{
-    optionType("Hash",         "spin",   "400",          "1", "57344"),
-    optionType("EvalFile",     "string", NETWORK_NAME,   "",  ""),
-    optionType("Threads",      "spin",   "1",            "1", "256"),
-    optionType("SyzygyPath",   "string", "<empty>",      "",  ""),
-    optionType("UCI_Chess960", "check",  "false",        "",  "")
+    optionType("Hash",            "spin",   "400",          "1", "57344"),
+    optionType("EvalFile",        "string", NETWORK_NAME,   "",  ""),
+    optionType("Threads",         "spin",   "1",            "1", "256"),
+    optionType("MultiPV",         "spin",   "1",            "1", "128"),
+    optionType("SyzygyPath",      "string", "<empty>",      "",  ""),
+    optionType("UCI_Chess960",    "check",  "false",        "",  ""),
+    optionType("OwnBook",         "check",  "false",        "",  ""),
+    optionType("BookFile",        "string", "<empty>",      "",  ""),
+    optionType("BookBestMove",    "check",  "false",        "",  ""),
+    optionType("ThreadBinding",   "combo",  "none",         {"none", "numa", "cpu"}),
+    optionType("HelperDepthSkip", "check",  "true",         "",  ""),
+    optionType("ProbCut",         "check",  "false",        "",  "")
 };
 
 // clang-format on
@@ -19,6 +26,9 @@ void uciOptions::printOptions()
         if (option.min != "")
             std::cout << " min " << option.min << " max " << option.max;
 
+        for (const auto &var : option.vars)
+            std::cout << " var " << var;
+
         std::cout << std::endl;
     }
 }
@@ -65,6 +75,31 @@ void uciOptions::uciChess960(Board &board, std::string_view v)
     board.chess960 = v == "true";
 }
 
+Numa::Binding uciOptions::uciThreadBinding(const std::string &value)
+{
+    return Numa::parseBinding(value);
+}
+
+bool uciOptions::uciBookFile(PolyglotBook &book, std::string input)
+{
+    std::string path = input.substr(input.find("value ") + 6);
+
+    if (path == "<empty>")
+    {
+        book.close();
+        return false;
+    }
+
+    if (!book.open(path))
+    {
+        std::cout << "BOOK NOT FOUND" << std::endl;
+        return false;
+    }
+
+    std::cout << "using book " << path << std::endl;
+    return true;
+}
+
 bool uciOptions::addIntTuneOption(std::string name, std::string type, int defaultValue, int min, int max)
 {
     optionsPrint.emplace_back(
@@ -3,6 +3,8 @@
 #include <algorithm>
 
 #include "board.h"
+#include "book.h"
+#include "numa.h"
 #include "helper.h"
 #include "nnue.h"
 #include "syzygy/Fathom/src/tbprobe.h"
@@ -19,6 +21,8 @@ struct optionType
     std::string defaultValue;
     std::string min;
     std::string max;
+    // values of a combo option
+    std::vector<std::string> vars;
     // constructor
     optionType(std::string name, std::string type, std::string defaultValue, std::string min, std::string max)
     {
@@ -28,6 +32,14 @@ struct optionType
         this->min = min;
         this->max = max;
     }
+
+    optionType(std::string name, std::string type, std::string defaultValue, std::vector<std::string> vars)
+    {
+        this->name = name;
+        this->type = type;
+        this->defaultValue = defaultValue;
+        this->vars = vars;
+    }
 };
 
 class uciOptions
@@ -58,6 +70,17 @@ class uciOptions
     /// @param v
     void uciChess960(Board &board, std::string_view v);
 
+    /// @brief set how search threads are placed on the cpus
+    /// @param value none, numa or cpu
+    /// @return
+    Numa::Binding uciThreadBinding(const std::string &value);
+
+    /// @brief map a polyglot book, "<empty>" unloads the book
+    /// @param book
+    /// @param input
+    /// @return true if a book is loaded
+    bool uciBookFile(PolyglotBook &book, std::string input);
+
     bool addIntTuneOption(std::string name, std::string type, int defaultValue, int min, int max);
     bool addDoubleTuneOption(std::string name, std::string type, double defaultValue, double min, double max);
 };
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+
 #include "types.h"
 
 static constexpr U64 RANDOM_ARRAY[781] = {
@@ -178,4 +180,29 @@ static constexpr U64 castlingKey[16] = {0,
                                         RANDOM_ARRAY[768 + 1] ^ RANDOM_ARRAY[768 + 2] ^ RANDOM_ARRAY[768 + 3] ^
                                             RANDOM_ARRAY[768]};
 
-static constexpr int hash_piece[12] = {1, 3, 5, 7, 9, 11, 0, 2, 4, 6, 8, 10};
\ No newline at end of file
+static constexpr int hash_piece[12] = {1, 3, 5, 7, 9, 11, 0, 2, 4, 6, 8, 10};
+
+// the most pieces of one kind, any fen can at most fill the board with them
+static constexpr int MAX_PIECE_COUNT = 64;
+
+/********************
+ * Keys of the material signature, materialKeys[piece][n] is added
+ * for the n + 1 th piece of its kind. Generated with splitmix64.
+ *******************/
+static constexpr auto materialKeys = [] {
+    std::array<std::array<U64, MAX_PIECE_COUNT>, 12> keys = {};
+    U64 state = 0x6D61746572696B65ULL;
+
+    for (auto &piece : keys)
+    {
+        for (auto &key : piece)
+        {
+            U64 z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            key = z ^ (z >> 31);
+        }
+    }
+
+    return keys;
+}();